@@ -0,0 +1,57 @@
+/**
+ *  binaryserialize.cpp
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *
+ *  Extension that makes the binary serialization of PHP-CPP available to
+ *  PHP scripts, so that the format can be checked with a round trip.
+ */
+
+/**
+ *  Libraries used.
+ */
+#include <phpcpp.h>
+
+/**
+ *  Serialize a value
+ *  @param  params
+ *  @return Php::Value
+ */
+Php::Value serialize(Php::Parameters &params)
+{
+    return Php::binary_serialize(params[0]);
+}
+
+/**
+ *  Unserialize a value
+ *  @param  params
+ *  @return Php::Value
+ */
+Php::Value unserialize(Php::Parameters &params)
+{
+    return Php::binary_unserialize(params[0]);
+}
+
+/**
+ *  Switch to C context so that the get_module() function can be
+ *  called by C programs (which the Zend engine is)
+ */
+extern "C"
+{
+    // export the "get_module" function that will be called by the Zend engine
+    PHPCPP_EXPORT void *get_module()
+    {
+        // create extension
+        static Php::Extension extension("binary_serialize","1.0");
+
+        // add the functions to the extension
+        extension.add<serialize>("binary_serialize", {
+            Php::ByVal("value")
+        });
+        extension.add<unserialize>("binary_unserialize", {
+            Php::ByVal("buffer", Php::Type::String)
+        });
+
+        // return the extension module
+        return extension;
+    }
+}
@@ -0,0 +1,29 @@
+<?php
+/**
+ *  binaryserialize.php
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *
+ *  Serialize values to the binary format and back, and check that the
+ *  result is identical to the original.
+ */
+
+// the values to check
+$values = array(
+    "scalars"   =>  array(null, true, false, 12, -3, 1.5, "text"),
+    "numeric"   =>  array(3 => "a", 1 => "b", "7" => "c"),
+    "nested"    =>  array(
+        "outer"     =>  array("inner" => array("deepest" => "x"), "next" => 1),
+        "second"    =>  array("inner" => "repeated key", "other" => array("a" => array("b" => 2))),
+        "last"      =>  "after the nested arrays",
+    ),
+);
+
+// check all values
+foreach ($values as $name => $value)
+{
+    // make a round trip
+    $result = binary_unserialize(binary_serialize($value));
+
+    // report the outcome
+    echo($name.": ".($result === $value ? "ok" : "FAILED")."\n");
+}
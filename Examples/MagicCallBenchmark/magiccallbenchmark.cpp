@@ -0,0 +1,80 @@
+/**
+ *  magiccallbenchmark.cpp
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *
+ *  Extension with a class that can be called both through a regular method
+ *  and through the magic __call() and __callStatic() methods, so that the
+ *  overhead of the magic dispatch can be measured.
+ */
+
+/**
+ *  Libraries used.
+ */
+#include <phpcpp.h>
+
+/**
+ *  Class with a regular method and magic methods that do the same
+ */
+class Counter : public Php::Base
+{
+private:
+    /**
+     *  The counter
+     *  @var    int64_t
+     */
+    int64_t _value = 0;
+
+public:
+    /**
+     *  Regular method
+     *  @param  params
+     *  @return Php::Value
+     */
+    Php::Value increment(Php::Parameters &params)
+    {
+        return _value += params.empty() ? 1 : params[0].numericValue();
+    }
+
+    /**
+     *  Magic method that is called for methods that do not exist
+     *  @param  name
+     *  @param  params
+     *  @return Php::Value
+     */
+    Php::Value __call(const char *name, Php::Parameters &params)
+    {
+        return _value += params.empty() ? 1 : params[0].numericValue();
+    }
+
+    /**
+     *  Magic method that is called for static methods that do not exist
+     *  @param  name
+     *  @param  params
+     *  @return Php::Value
+     */
+    static Php::Value __callStatic(const char *name, Php::Parameters &params)
+    {
+        return params.empty() ? 1 : params[0].numericValue();
+    }
+};
+
+// Symbols are exported according to the "C" language
+extern "C"
+{
+    // export the "get_module" function that will be called by the Zend engine
+    PHPCPP_EXPORT void *get_module()
+    {
+        // create extension
+        static Php::Extension extension("magic_call_benchmark","1.0");
+
+        // the class with the regular and the magic methods
+        Php::Class<Counter> counter("Counter");
+        counter.method<&Counter::increment>("increment");
+
+        // add the class to the extension
+        extension.add(std::move(counter));
+
+        // return the extension module
+        return extension;
+    }
+}
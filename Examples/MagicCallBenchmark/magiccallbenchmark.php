@@ -0,0 +1,49 @@
+<?php
+/**
+ *  magiccallbenchmark.php
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *
+ *  Compare the time it takes to call a regular method with the time it
+ *  takes to call the same code through __call() and __callStatic().
+ */
+
+// number of calls to make
+$count = isset($argv[1]) ? intval($argv[1]) : 1000000;
+
+// the object to call
+$counter = new Counter();
+
+/**
+ *  Run a benchmark
+ *  @param  string      name of the benchmark
+ *  @param  callable    function that makes the calls
+ */
+function benchmark($name, $function)
+{
+    global $count;
+
+    // time the calls
+    $start = microtime(true);
+    $function($count);
+    $elapsed = microtime(true) - $start;
+
+    // report the results
+    printf("%-24s %8.3f s %10.1f ns/call\n", $name, $elapsed, $elapsed * 1e9 / $count);
+}
+
+benchmark("regular method", function($count) use ($counter) {
+    for ($i = 0; $i < $count; $i++) $counter->increment(1);
+});
+
+benchmark("__call", function($count) use ($counter) {
+    for ($i = 0; $i < $count; $i++) $counter->missing(1);
+});
+
+benchmark("__callStatic", function($count) {
+    for ($i = 0; $i < $count; $i++) Counter::missing(1);
+});
+
+benchmark("__call (callable)", function($count) use ($counter) {
+    $callable = array($counter, 'missing');
+    for ($i = 0; $i < $count; $i++) call_user_func($callable, 1);
+});
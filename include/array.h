@@ -58,6 +58,14 @@ public:
     template <typename T>
     Array(const std::map<std::string,T> &value) : Value(value) {}
 
+    /**
+     *  Constructor from an unordered map (this will create an array that
+     *  can have both numeric and string keys)
+     *  @param  value
+     */
+    template <typename T>
+    Array(const std::unordered_map<Key,T> &value) : Value(value) {}
+
 // old visual c++ environments have no support for initializer lists
 #   if !defined(_MSC_VER) || _MSC_VER >= 1800
 
@@ -75,6 +83,18 @@ public:
      */
     virtual ~Array() {}
 
+    /**
+     *  Allocate room for a certain number of elements, so that the array
+     *  does not have to grow while it is being filled. Note that this only
+     *  has effect on an array that is still empty.
+     *  @param  size        Expected number of elements
+     */
+    void reserve(size_t size)
+    {
+        // pass on to the base class
+        reserveArray(size);
+    }
+
     /**
      *  Change the internal type of the variable
      *  @param  Type
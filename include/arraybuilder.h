@@ -0,0 +1,112 @@
+/**
+ *  ArrayBuilder.h
+ *
+ *  Class to efficiently build a big array that is going to be passed to
+ *  PHP space. The builder allocates the hash table at its final size right
+ *  away, and appends elements without the copy-on-write checks that the
+ *  regular Value::set() methods have to do for every element.
+ *
+ *      Php::ArrayBuilder builder(records.size());
+ *      for (auto &record : records) builder.append(record.score);
+ *      return builder.value();
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2019 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Class definition
+ */
+class PHPCPP_EXPORT ArrayBuilder
+{
+public:
+    /**
+     *  Constructor
+     *  @param  size        Expected number of elements
+     */
+    explicit ArrayBuilder(size_t size = 0);
+
+    /**
+     *  The builder can not be copied
+     *  @param  that
+     */
+    ArrayBuilder(const ArrayBuilder &that) = delete;
+
+    /**
+     *  Destructor
+     */
+    ~ArrayBuilder() {}
+
+    /**
+     *  Append an element to the end of the array
+     *  @param  value
+     *  @return ArrayBuilder
+     */
+    ArrayBuilder &append(std::nullptr_t value);
+    ArrayBuilder &append(int16_t value) { return append((int64_t)value); }
+    ArrayBuilder &append(int32_t value) { return append((int64_t)value); }
+    ArrayBuilder &append(int64_t value);
+    ArrayBuilder &append(bool value);
+    ArrayBuilder &append(char value) { return append(StringView(&value, 1)); }
+    ArrayBuilder &append(double value);
+    ArrayBuilder &append(const char *value) { return append(StringView(value)); }
+    ArrayBuilder &append(const std::string &value) { return append(StringView(value)); }
+    ArrayBuilder &append(const StringView &value);
+    ArrayBuilder &append(const Value &value);
+
+    /**
+     *  Append all elements from a range
+     *  @param  begin       Iterator to the first element
+     *  @param  end         Iterator past the last element
+     *  @return ArrayBuilder
+     */
+    template <typename Iterator>
+    ArrayBuilder &append(Iterator begin, Iterator end)
+    {
+        // append all elements
+        for (; begin != end; ++begin) append(*begin);
+
+        // allow chaining
+        return *this;
+    }
+
+    /**
+     *  Set an element with a specific key
+     *  @param  key         The key
+     *  @param  value       The value
+     *  @return ArrayBuilder
+     */
+    ArrayBuilder &set(int64_t index, const Value &value);
+    ArrayBuilder &set(const std::string &key, const Value &value);
+    ArrayBuilder &set(const Key &key, const Value &value);
+
+    /**
+     *  Number of elements in the array
+     *  @return size_t
+     */
+    size_t size() const { return _array.size(); }
+
+    /**
+     *  Retrieve the array that was built. After this call the builder is
+     *  no longer usable.
+     *  @return Value
+     */
+    Value value() { return std::move(_array); }
+
+private:
+    /**
+     *  The array that is being built
+     *  @var Value
+     */
+    Value _array;
+};
+
+/**
+ *  End of namespace
+ */
+}
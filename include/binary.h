@@ -0,0 +1,52 @@
+/**
+ *  Binary.h
+ *
+ *  Functions to serialize a value into a compact binary format, and to turn
+ *  such a binary string back into a value. This is much faster than calling
+ *  the serialize() and unserialize() functions from PHP space, and the
+ *  output is smaller, but only null, booleans, numbers, strings and (nested)
+ *  arrays can be serialized.
+ *
+ *  The format is meant for caches and other storage that is read back by
+ *  the same extension: integers are stored as variable length numbers,
+ *  floating point numbers are stored in the native byte order, and strings
+ *  that occur more than once (like the keys of a list of records) are only
+ *  stored once.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2019 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Serialize a value into a binary string
+ *
+ *  This throws an exception when the value holds an object or a resource,
+ *  or when the arrays are nested too deep.
+ *
+ *  @param  value       The value to serialize
+ *  @return Value       The binary string
+ */
+extern PHPCPP_EXPORT Value binary_serialize(const Value &value);
+
+/**
+ *  Turn a binary string that was created with binary_serialize() back into
+ *  a value. This throws an exception when the input is not valid.
+ *
+ *  @param  buffer      The binary string
+ *  @param  size        Size of the binary string
+ *  @return Value
+ */
+extern PHPCPP_EXPORT Value binary_unserialize(const char *buffer, size_t size);
+inline PHPCPP_EXPORT Value binary_unserialize(const StringView &buffer) { return binary_unserialize(buffer.data(), buffer.size()); }
+inline PHPCPP_EXPORT Value binary_unserialize(const std::string &buffer) { return binary_unserialize(buffer.data(), buffer.size()); }
+inline PHPCPP_EXPORT Value binary_unserialize(const Value &buffer) { return binary_unserialize(buffer.stringView()); }
+
+/**
+ *  End of namespace
+ */
+}
@@ -0,0 +1,123 @@
+/**
+ *  CallSite.h
+ *
+ *  A call site is a function or method that is resolved once, and that can
+ *  then be called over and over again. Calling a Php::Value (or calling a
+ *  method on it) looks up the function by its name on every call, a call
+ *  site does this only when it is constructed.
+ *
+ *      Php::CallSite callback(params[0]);
+ *      for (auto &row : rows) callback(row.id, row.name);
+ *
+ *  The resolved function is only valid during the current request, so a
+ *  call site should not be stored in a static or global variable.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2019 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Class definition
+ */
+class PHPCPP_EXPORT CallSite
+{
+public:
+    /**
+     *  Constructor for anything that is callable: the name of a function,
+     *  a closure, an invokable object, or an array holding an object and
+     *  the name of a method
+     *
+     *  This throws an exception if the value is not callable
+     *
+     *  @param  callable    The function to call
+     */
+    CallSite(const Value &callable);
+
+    /**
+     *  Constructor for a method of an object
+     *
+     *  This throws an exception if the object has no such method
+     *
+     *  @param  object      The object
+     *  @param  method      Name of the method
+     */
+    CallSite(const Value &object, const char *method);
+
+    /**
+     *  A call site can not be copied
+     *  @param  that
+     */
+    CallSite(const CallSite &that) = delete;
+
+    /**
+     *  Destructor
+     */
+    virtual ~CallSite();
+
+    /**
+     *  Call the function
+     *  @param  args        Optional arguments
+     *  @return Value
+     */
+    template <typename ...Args>
+    Value operator()(Args&&... args)
+    {
+        // store arguments
+        Value vargs[] = { static_cast<Value>(args)... };
+
+        // array of parameters
+        _zval_struct **params[sizeof...(Args)];
+        for(unsigned i=0; i < sizeof...(Args); i++) {params[i] = &vargs[i]._val;}
+
+        // call the function
+        return exec(sizeof...(Args), params);
+    }
+
+    /**
+     *  Call the function without arguments
+     *  @return Value
+     */
+    Value operator()() { return exec(0, nullptr); }
+
+private:
+    /**
+     *  The callable (this keeps the function and the object alive)
+     *  @var Value
+     */
+    Value _callable;
+
+    /**
+     *  Structure holding the zend call info and the resolved function
+     *  (this is defined in the implementation file)
+     */
+    struct Data;
+
+    /**
+     *  The call info and the resolved function
+     *  @var Data
+     */
+    Data *_data;
+
+    /**
+     *  Resolve the function
+     */
+    void resolve();
+
+    /**
+     *  Call the function with a number of parameters
+     *  @param  argc        Number of parameters
+     *  @param  params      The parameters
+     *  @return Value
+     */
+    Value exec(int argc, struct _zval_struct ***params);
+};
+
+/**
+ *  End of namespace
+ */
+}
@@ -268,6 +268,23 @@ public:
     Class<T> &property(const char *name, Value (T::*getter)()      , void (T::*setter)(const Value &value) const) { ClassBase::property(name, static_cast<getter_callback_0>(getter), static_cast<setter_callback_1>(setter)); return *this; }
     Class<T> &property(const char *name, Value (T::*getter)() const, void (T::*setter)(const Value &value) const) { ClassBase::property(name, static_cast<getter_callback_1>(getter), static_cast<setter_callback_1>(setter)); return *this; }
 
+    /**
+     *  Properties as data members
+     *
+     *  A property can also be bound directly to a data member of the class.
+     *  Reading or writing the property then reads or writes the member,
+     *  without calling a method. The value that is assigned to the property
+     *  is converted to the type of the member.
+     *
+     *  @param  name        Name of the property
+     *  @param  member      The data member
+     *  @return Class       Same object to allow chaining
+     */
+    Class<T> &property(const char *name, int64_t T::*member)     { ClassBase::property(name, static_cast<int_member>(member)); return *this; }
+    Class<T> &property(const char *name, double T::*member)      { ClassBase::property(name, static_cast<float_member>(member)); return *this; }
+    Class<T> &property(const char *name, bool T::*member)        { ClassBase::property(name, static_cast<bool_member>(member)); return *this; }
+    Class<T> &property(const char *name, std::string T::*member) { ClassBase::property(name, static_cast<string_member>(member)); return *this; }
+
     /**
      *  Add a PHP interface to the class
      *
@@ -296,64 +313,105 @@ public:
     template<typename CLASS>
     Class<T> &extends(const Class<CLASS> &base) { ClassBase::extends(base); return *this; }
 
+    /**
+     *  Reuse the memory of destructed objects
+     *
+     *  When an object of this class is destructed, its memory is kept in a
+     *  pool, and used again for the next object of this class that is
+     *  created. This saves work for classes of which many short-lived objects
+     *  are created. The pool only holds memory during a request, it is
+     *  emptied when the request ends. In thread safe mode there is no pool.
+     *
+     *  @param  limit       Max number of objects to keep, zero to disable
+     *  @return Class       Same object to allow chaining
+     */
+    Class<T> &pool(size_t limit = 1024) { ClassBase::pool(limit); return *this; }
+
+    /**
+     *  Statistics of the memory pool (see pool())
+     *  @return PoolStatistics
+     */
+    const PoolStatistics &statistics() const { return ClassBase::statistics(); }
+
 private:
     /**
      *  Method to create the object if it is default constructable
-     *  @param  orig
+     *  @param  memory
      *  @return Base*
      */
     template <typename X = T>
     typename std::enable_if<std::is_default_constructible<X>::value, Base*>::type
-    static maybeConstruct()
+    static maybeConstruct(void *memory)
     {
         // create a new instance
-        return new X();
+        return new (memory) X();
     }
 
     /**
      *  Method to create the object if it is not default constructable
-     *  @param  orig
+     *  @param  memory
      *  @return Base*
      */
     template <typename X = T>
     typename std::enable_if<!std::is_default_constructible<X>::value, Base*>::type
-    static maybeConstruct()
+    static maybeConstruct(void *memory)
     {
         // create empty instance
         return nullptr;
     }
 
+    /**
+     *  Size of the objects
+     *  @return size_t
+     */
+    virtual size_t size() const override
+    {
+        return sizeof(T);
+    }
+
+    /**
+     *  Memory alignment of the objects
+     *  @return size_t
+     */
+    virtual size_t alignment() const override
+    {
+        return alignof(T);
+    }
+
     /**
      *  Construct a new instance of the object
+     *  @param  memory
      *  @return Base
      */
-    virtual Base* construct() const override
+    virtual Base* construct(void *memory) const override
     {
         // construct an instance
-        return maybeConstruct<T>();
+        return maybeConstruct<T>(memory);
     }
 
     /**
      *  Method to clone the object if it is copy constructable
+     *  @param  memory
      *  @param  orig
      *  @return Base*
      */
     template <typename X = T>
     typename std::enable_if<std::is_copy_constructible<X>::value, Base*>::type
-    static maybeClone(X *orig)
+    static maybeClone(void *memory, X *orig)
     {
         // create a new instance
-        return new X(*orig);
+        return new (memory) X(*orig);
     }
 
     /**
      *  Method to clone the object if it is not copy constructable
+     *  @param  memory
      *  @param  orig
      *  @return Base*
      */
     template <typename X = T>
     typename std::enable_if<!std::is_copy_constructible<X>::value, Base*>::type
-    static maybeClone(X *orig)
+    static maybeClone(void *memory, X *orig)
     {
         // impossible return null
         return nullptr;
@@ -370,13 +428,14 @@ private:
 
     /**
      *  Construct a clone
+     *  @param  memory
      *  @param  orig
      *  @return Base
      */
-    virtual Base *clone(Base *orig) const override
+    virtual Base *clone(void *memory, Base *orig) const override
     {
         // maybe clone it (if the class has a copy constructor)
-        return maybeClone<T>((T*)orig);
+        return maybeClone<T>(memory, (T*)orig);
     }
 
     /**
@@ -61,6 +61,14 @@ typedef Value   (Base::*getter_callback_1)() const;
 typedef void    (Base::*setter_callback_0)(const Php::Value &value);
 typedef void    (Base::*setter_callback_1)(const Php::Value &value) const;
 
+/**
+ *  Data members that properties can be bound to
+ */
+typedef int64_t     Base::*int_member;
+typedef double      Base::*float_member;
+typedef bool        Base::*bool_member;
+typedef std::string Base::*string_member;
+
 /**
  *  Forward declarations
  */
@@ -105,11 +113,21 @@ public:
     virtual ~ClassBase() {}
 
     /**
-     *  Construct a new instance of the object, or to clone the object
+     *  Size and memory alignment of the C++ objects, so that memory can be
+     *  allocated for them together with the PHP object
+     *  @return size_t
+     */
+    virtual size_t size()           const { return 0; }
+    virtual size_t alignment()      const { return 1; }
+
+    /**
+     *  Construct a new instance of the object, or to clone the object, in
+     *  memory that holds size() bytes, aligned to alignment()
+     *  @param  memory
      *  @return Base
      */
-    virtual Base *construct()       const { return nullptr; }
-    virtual Base *clone(Base *orig) const { return nullptr; }
+    virtual Base *construct(void *memory)               const { return nullptr; }
+    virtual Base *clone(void *memory, Base *orig)       const { return nullptr; }
 
     /**
      *  Methods to check if a certain interface is overridden, or a copy
@@ -285,6 +303,16 @@ protected:
     void property(const char *name, const getter_callback_0 &getter, const setter_callback_1 &setter);
     void property(const char *name, const getter_callback_1 &getter, const setter_callback_1 &setter);
 
+    /**
+     *  Set property that is bound to a data member
+     *  @param  name        Name of the property
+     *  @param  member      The data member
+     */
+    void property(const char *name, const int_member &member);
+    void property(const char *name, const float_member &member);
+    void property(const char *name, const bool_member &member);
+    void property(const char *name, const string_member &member);
+
     /**
      *  Add an interface
      *  @param  interface       Interface object
@@ -297,6 +325,18 @@ protected:
      */
     void extends(const ClassBase &base);
 
+    /**
+     *  Reuse the memory of destructed objects for new objects
+     *  @param  limit           Max number of objects to keep, zero to disable
+     */
+    void pool(size_t limit);
+
+    /**
+     *  Statistics of the memory pool
+     *  @return PoolStatistics
+     */
+    const PoolStatistics &statistics() const;
+
 private:
     /**
      *  Pointer to the actual implementation
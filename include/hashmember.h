@@ -148,6 +148,19 @@ public:
         return value().floatValue();
     }
 
+    /**
+     *  Get a borrowed view on the string buffer
+     *
+     *  Just like the cast to a byte array, this only works for string values
+     *  that are stored in the parent, other variables return an empty view
+     *
+     *  @return StringView
+     */
+    StringView stringView() const
+    {
+        return value().stringView();
+    }
+
     /**
      *  Array access operator
      *  This can be used for accessing arrays
@@ -181,6 +194,17 @@ public:
         return HashMember<std::string>(this, key);
     }
 
+    /**
+     *  Array access operator
+     *  This can be used for accessing associative arrays with a precomputed key
+     *  @param  key
+     *  @return HashMember
+     */
+    HashMember<Key> operator[](const Key &key)
+    {
+        return HashMember<Key>(this, key);
+    }
+
     /**
      *  Add a value to the object (or other arithmetric operators)
      *  @param  value
@@ -401,6 +425,17 @@ public:
         return exists() && value().contains(key);
     }
 
+    /**
+     *  Check if a certain key exists in the array/object
+     *  @param  key
+     *  @return bool
+     */
+    virtual bool contains(const Key &key) const override
+    {
+        // object must exist, and the value must contain the key
+        return exists() && value().contains(key);
+    }
+
     /**
      *  Retrieve the value at a string index
      *  @param  key
@@ -443,6 +478,20 @@ public:
         return value().get(key);
     }
 
+    /**
+     *  Retrieve the value at a key with a precomputed hash
+     *  @param  key
+     *  @return Value
+     */
+    virtual Value get(const Key &key) const override
+    {
+        // return null if it does not exist
+        if (!exists()) return nullptr;
+
+        // ask the value
+        return value().get(key);
+    }
+
     /**
      *  Overwrite the value at a certain string index
      *  @param  key
@@ -494,6 +543,23 @@ public:
         _parent->set(_index, current);
     }
 
+    /**
+     *  Overwrite the value at a key with a precomputed hash
+     *  @param  key
+     *  @param  value
+     */
+    virtual void set(const Key &key, const Value &value) override
+    {
+        // get the current value
+        Value current(this->value());
+
+        // add the value
+        current.set(key, value);
+
+        // pass this to the base
+        _parent->set(_index, current);
+    }
+
     /**
      *  Unset the member
      */
@@ -568,6 +634,28 @@ public:
         _parent->set(_index, current);
     }
 
+    /**
+     *  Unset a member by a key with a precomputed hash
+     *  @param  key
+     */
+    virtual void unset(const Key &key) override
+    {
+        // if the current property does not even exist, we do not have to add anything
+        if (!exists()) return;
+
+        // get the current value
+        Value current(this->value());
+
+        // skip if the property does not exist
+        if (!current.contains(key)) return;
+
+        // remove the index
+        current.unset(key);
+
+        // pass the new value to the base
+        _parent->set(_index, current);
+    }
+
 protected:
     /**
      *  Protected copy constructor
@@ -601,6 +689,7 @@ private:
     friend class HashMember<std::string>;
     friend class HashMember<Value>;
     friend class HashMember<int>;
+    friend class HashMember<Key>;
     friend class Base;
     friend class Value;
 };
@@ -613,6 +702,7 @@ private:
  */
 PHPCPP_EXPORT std::ostream &operator<<(std::ostream &stream, const HashMember<int> &value);
 PHPCPP_EXPORT std::ostream &operator<<(std::ostream &stream, const HashMember<std::string> &value);
+PHPCPP_EXPORT std::ostream &operator<<(std::ostream &stream, const HashMember<Key> &value);
 
 
 /**
@@ -62,6 +62,13 @@ public:
      */
     virtual bool contains(const Value &index) const = 0;
 
+    /**
+     *  Check if a certain key exists in the array/object
+     *  @param  key
+     *  @return bool
+     */
+    virtual bool contains(const Key &key) const = 0;
+
     /**
      *  Retrieve the value at a string index
      *  @param  key
@@ -83,6 +90,13 @@ public:
      */
     virtual Value get(const Value &key) const = 0;
 
+    /**
+     *  Retrieve the value at a key with a precomputed hash
+     *  @param  key
+     *  @return Value
+     */
+    virtual Value get(const Key &key) const = 0;
+
     /**
      *  Overwrite the value at a certain string index
      *  @param  key
@@ -104,6 +118,13 @@ public:
      */
     virtual void set(const Value &key, const Value &value) = 0;
 
+    /**
+     *  Overwrite the value at a key with a precomputed hash
+     *  @param  key
+     *  @param  value
+     */
+    virtual void set(const Key &key, const Value &value) = 0;
+
     /**
      *  Unset a member by its index
      *  @param  index
@@ -122,6 +143,12 @@ public:
      */
     virtual void unset(const Value &key) = 0;
 
+    /**
+     *  Unset a member by a key with a precomputed hash
+     *  @param  key
+     */
+    virtual void unset(const Key &key) = 0;
+
 };
 
 /**
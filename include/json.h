@@ -0,0 +1,72 @@
+/**
+ *  Json.h
+ *
+ *  Functions to turn a value into JSON, and to parse JSON into a value,
+ *  without calling the json_encode() and json_decode() functions from PHP
+ *  space. The encoder writes straight into the output (a string or a C++
+ *  stream like Php::out), and the decoder can read from a C++ stream, so
+ *  big documents do not have to be copied into a buffer first.
+ *
+ *  The output is the same as the output of json_encode() with the default
+ *  options: slashes and non-ascii characters are escaped. The decoder
+ *  follows the same rules as json_decode(): numbers that do not fit in an
+ *  integer become floating point numbers, and numeric keys in objects
+ *  become numeric keys in arrays.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2019 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Turn a value into JSON
+ *
+ *  This throws an exception when the value can not be encoded, for example
+ *  because a string holds invalid UTF-8, or because the value is nested too
+ *  deep.
+ *
+ *  @param  value       The value to encode
+ *  @return Value       String holding the JSON
+ */
+extern PHPCPP_EXPORT Value json_encode(const Value &value);
+
+/**
+ *  Write a value as JSON to a stream
+ *  @param  value       The value to encode
+ *  @param  stream      The stream to write to
+ */
+extern PHPCPP_EXPORT void json_encode(const Value &value, std::ostream &stream);
+
+/**
+ *  Parse JSON into a value
+ *
+ *  This throws an exception when the input is not valid JSON.
+ *
+ *  @param  buffer      The JSON
+ *  @param  size        Size of the JSON
+ *  @param  assoc       Turn objects into associative arrays (instead of stdClass objects)
+ *  @return Value
+ */
+extern PHPCPP_EXPORT Value json_decode(const char *buffer, size_t size, bool assoc = false);
+inline PHPCPP_EXPORT Value json_decode(const StringView &buffer, bool assoc = false) { return json_decode(buffer.data(), buffer.size(), assoc); }
+inline PHPCPP_EXPORT Value json_decode(const std::string &buffer, bool assoc = false) { return json_decode(buffer.data(), buffer.size(), assoc); }
+
+/**
+ *  Parse JSON from a stream into a value. Only a small part of the input is
+ *  kept in memory, so this can be used for documents that are too big to
+ *  load in a buffer first.
+ *
+ *  @param  stream      The stream to read from
+ *  @param  assoc       Turn objects into associative arrays (instead of stdClass objects)
+ *  @return Value
+ */
+extern PHPCPP_EXPORT Value json_decode(std::istream &stream, bool assoc = false);
+
+/**
+ *  End of namespace
+ */
+}
@@ -0,0 +1,167 @@
+/**
+ *  Key.h
+ *
+ *  A key is a string that is used to look up members in an array or an
+ *  object. When a key is constructed, the hash value that the Zend engine
+ *  uses for it is calculated right away. Array lookups with a Key object
+ *  therefore do not have to hash the key over and over again.
+ *
+ *  If you often access arrays with the same keys (for example when you map
+ *  records to C++ objects), it is a good idea to create the Key objects once
+ *  and reuse them for every lookup:
+ *
+ *      static const Php::Key name("name");
+ *      for (auto &iter : records) process(iter.second[name]);
+ *
+ *  A key can also hold a numeric index. Strings that PHP treats as numbers
+ *  (like "12") are turned into numeric keys too, just like PHP does when such
+ *  a string is used as an array key.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2019 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Class definition
+ */
+class PHPCPP_EXPORT Key
+{
+public:
+    /**
+     *  Constructor
+     *  @param  key         The key
+     *  @param  size        Size of the key
+     */
+    Key(const char *key, size_t size);
+
+    /**
+     *  Constructor
+     *  @param  key         The key
+     */
+    explicit Key(const char *key) : Key(key, ::strlen(key)) {}
+
+    /**
+     *  Constructor
+     *  @param  key         The key
+     */
+    explicit Key(const std::string &key) : Key(key.data(), key.size()) {}
+
+    /**
+     *  Constructor for a string key of which the hash is already known, for
+     *  example because it comes straight from a hash table. The key must not
+     *  be numeric, and the hash must be the one that zend would calculate.
+     *  @param  key         The key
+     *  @param  size        Size of the key
+     *  @param  hash        The hash value
+     */
+    Key(const char *key, size_t size, unsigned long hash) : _key(key, size), _hash(hash), _numeric(false) {}
+
+    /**
+     *  Constructor for a numeric key
+     *  @param  index       The index
+     */
+    explicit Key(int64_t index);
+
+    /**
+     *  Is this a numeric key?
+     *  @return bool
+     */
+    bool isNumeric() const { return _numeric; }
+
+    /**
+     *  The numeric index (only meaningful for numeric keys)
+     *  @return int64_t
+     */
+    int64_t index() const { return (long)_hash; }
+
+    /**
+     *  The key
+     *  @return const char *
+     */
+    const char *data() const { return _key.c_str(); }
+
+    /**
+     *  Size of the key
+     *  @return size_t
+     */
+    size_t size() const { return _key.size(); }
+
+    /**
+     *  The hash value that is used by the zend engine for the key, for
+     *  numeric keys this is the index itself
+     *  @return unsigned long
+     */
+    unsigned long hash() const { return _hash; }
+
+    /**
+     *  The key as a std::string
+     *  @return std::string
+     */
+    const std::string &str() const { return _key; }
+
+    /**
+     *  Cast to a std::string
+     *  @return std::string
+     */
+    operator const std::string & () const { return _key; }
+
+    /**
+     *  Comparison operators, numeric keys are ordered before string keys
+     *  @param  that
+     *  @return bool
+     */
+    bool operator==(const Key &that) const { return _hash == that._hash && _numeric == that._numeric && _key == that._key; }
+    bool operator!=(const Key &that) const { return !operator==(that); }
+    bool operator< (const Key &that) const
+    {
+        // numeric keys come first
+        if (_numeric != that._numeric) return _numeric;
+
+        // compare numeric keys by their index, and strings by their content
+        return _numeric ? index() < that.index() : _key < that._key;
+    }
+
+private:
+    /**
+     *  The key
+     *  @var std::string
+     */
+    std::string _key;
+
+    /**
+     *  The precomputed hash
+     *  @var unsigned long
+     */
+    unsigned long _hash;
+
+    /**
+     *  Is this a numeric key?
+     *  @var bool
+     */
+    bool _numeric;
+};
+
+/**
+ *  End of namespace
+ */
+}
+
+/**
+ *  Keys can be used in unordered containers
+ */
+namespace std {
+
+    /**
+     *  Hash function, this reuses the hash that was already calculated
+     */
+    template <>
+    struct hash<Php::Key>
+    {
+        size_t operator()(const Php::Key &key) const { return key.hash(); }
+    };
+}
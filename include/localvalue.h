@@ -0,0 +1,194 @@
+/**
+ *  LocalValue.h
+ *
+ *  A LocalValue is a lightweight alternative for the Php::Value class,
+ *  meant for short-lived temporary values that never leave the C++ stack
+ *  frame in which they were created, like counters and intermediate results
+ *  in numeric loops.
+ *
+ *  A regular Php::Value allocates a zval on the heap, even when it only
+ *  holds an integer. A LocalValue keeps the zval inline in the object
+ *  itself, and only allocates a heap zval at the moment that it is turned
+ *  into a Php::Value (for example because it is stored in an array, or
+ *  returned to PHP space).
+ *
+ *  A LocalValue can only hold scalar values: null, numbers, booleans,
+ *  floating point numbers and strings.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2019 Copernica BV
+ */
+
+/**
+ *  Forward definitions
+ */
+struct _zval_struct;
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Class definition
+ */
+class PHPCPP_EXPORT LocalValue
+{
+public:
+    /**
+     *  Empty constructor (value = NULL)
+     */
+    LocalValue();
+
+    /**
+     *  Constructor for various types
+     *  @param  value
+     */
+    LocalValue(std::nullptr_t value);
+    LocalValue(int16_t value);
+    LocalValue(int32_t value);
+    LocalValue(int64_t value);
+    LocalValue(bool value);
+    LocalValue(char value);
+    LocalValue(const std::string &value);
+    LocalValue(const char *value, int size = -1);
+    LocalValue(double value);
+
+    /**
+     *  Copy constructor
+     *  @param  that
+     */
+    LocalValue(const LocalValue &that);
+
+    /**
+     *  Move constructor
+     *  @param  that
+     */
+    LocalValue(LocalValue &&that) _NOEXCEPT;
+
+    /**
+     *  Destructor
+     */
+    ~LocalValue();
+
+    /**
+     *  Assignment operators
+     *  @param  value
+     *  @return LocalValue
+     */
+    LocalValue &operator=(const LocalValue &value);
+    LocalValue &operator=(LocalValue &&value) _NOEXCEPT;
+    LocalValue &operator=(std::nullptr_t value);
+    LocalValue &operator=(int16_t value);
+    LocalValue &operator=(int32_t value);
+    LocalValue &operator=(int64_t value);
+    LocalValue &operator=(bool value);
+    LocalValue &operator=(char value);
+    LocalValue &operator=(const std::string &value);
+    LocalValue &operator=(const char *value);
+    LocalValue &operator=(double value);
+
+    /**
+     *  Arithmetic operators that modify the value in place, these follow the
+     *  same rules as PHP does (so an integer overflow turns the value into
+     *  a floating point number)
+     *  @param  value
+     *  @return LocalValue
+     */
+    LocalValue &operator+=(int64_t value);
+    LocalValue &operator+=(double value);
+    LocalValue &operator-=(int64_t value);
+    LocalValue &operator-=(double value);
+    LocalValue &operator*=(int64_t value);
+    LocalValue &operator*=(double value);
+    LocalValue &operator/=(int64_t value);
+    LocalValue &operator/=(double value);
+
+    /**
+     *  The type of the value
+     *  @return Type
+     */
+    Type type() const;
+
+    /**
+     *  Check if the value is of a certain type
+     *  @return bool
+     */
+    bool isNull()       const { return type() == Type::Null; }
+    bool isNumeric()    const { return type() == Type::Numeric; }
+    bool isBool()       const { return type() == Type::Bool; }
+    bool isString()     const { return type() == Type::String; }
+    bool isFloat()      const { return type() == Type::Float; }
+
+    /**
+     *  Retrieve the value as number
+     *  @return int64_t
+     */
+    int64_t numericValue() const;
+
+    /**
+     *  Retrieve the value as boolean
+     *  @return bool
+     */
+    bool boolValue() const;
+
+    /**
+     *  Retrieve the value as a string
+     *  @return string
+     */
+    std::string stringValue() const;
+
+    /**
+     *  Retrieve the value as decimal
+     *  @return double
+     */
+    double floatValue() const;
+
+    /**
+     *  Cast operators
+     *  @return mixed
+     */
+    operator int16_t () const { return (int16_t)numericValue(); }
+    operator int32_t () const { return (int32_t)numericValue(); }
+    operator int64_t () const { return numericValue(); }
+    operator bool () const { return boolValue(); }
+    operator std::string () const { return stringValue(); }
+    operator double () const { return floatValue(); }
+
+    /**
+     *  Turn the local value into a regular Php::Value. This is the moment
+     *  that a zval is allocated on the heap. Note that the Php::Value class
+     *  also has a constructor that accepts a LocalValue, so you can also pass
+     *  a LocalValue to all functions that accept a Php::Value
+     *  @return Value
+     */
+    Value value() const { return Value(*this); }
+
+private:
+    /**
+     *  Storage for the inline zval. The zval type is not known in the public
+     *  header files, so we reserve enough room for it (this is checked by
+     *  a static assertion in the implementation file)
+     */
+    union {
+        double _align;
+        char _storage[2 * sizeof(void *) + 8];
+    };
+
+    /**
+     *  The Value class copies the inline zval when it is constructed
+     */
+    friend class Value;
+
+    /**
+     *  Access to the inline zval
+     *  @return zval
+     */
+    struct _zval_struct *val();
+    const struct _zval_struct *val() const;
+};
+
+/**
+ *  End of namespace
+ */
+}
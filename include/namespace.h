@@ -108,6 +108,33 @@ public:
     template <Value (*callback)()>                          Namespace &add(const char *name, const Arguments &arguments = {}) { return add(name, &ZendCallable::invoke<callback>, arguments); }
     template <Value (*callback)(Parameters &parameters)>    Namespace &add(const char *name, const Arguments &arguments = {}) { return add(name, &ZendCallable::invoke<callback>, arguments); }
 
+    /**
+     *  Add a native function with a plain C++ signature (see TypedFunction.h)
+     *
+     *      extension.add<decltype(&scale), &scale>("scale");
+     *
+     *  @param  name        Name of the function
+     *  @param  arguments   Optional argument specification
+     *  @return Same object to allow chaining
+     */
+    template <typename F, F callback>
+    Namespace &add(const char *name, const Arguments &arguments = {}) { return add(name, &TypedFunction<F, callback>::invoke, arguments); }
+
+#if __cplusplus >= 201703L
+    /**
+     *  Add a native function with a plain C++ signature, without having to
+     *  spell out its type
+     *
+     *      extension.add<&scale>("scale");
+     *
+     *  @param  name        Name of the function
+     *  @param  arguments   Optional argument specification
+     *  @return Same object to allow chaining
+     */
+    template <auto callback, typename = typename std::enable_if<!IsParametersFunction<decltype(callback)>::value>::type>
+    Namespace &add(const char *name, const Arguments &arguments = {}) { return add(name, &TypedFunction<decltype(callback), callback>::invoke, arguments); }
+#endif
+
     /**
      *  Add a native function directly to the namespace
      *  @param  name        Name of the function
@@ -20,7 +20,7 @@ class Base;
 /**
  *  Class definition
  */
-class PHPCPP_EXPORT Parameters : public std::vector<Value>
+class PHPCPP_EXPORT Parameters : public SmallVector<Value, 4>
 {
 private:
     /**
@@ -0,0 +1,51 @@
+/**
+ *  PoolStatistics.h
+ *
+ *  Statistics of the memory pool of a class. When a class is registered
+ *  with a pool (see Class::pool()), the memory of destructed objects is
+ *  kept and reused for new objects of the same class. These statistics
+ *  show how well that works.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2019 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Structure definition
+ */
+struct PoolStatistics
+{
+    /**
+     *  Number of objects that were created in memory from the pool
+     *  @var    size_t
+     */
+    size_t hits = 0;
+
+    /**
+     *  Number of objects for which new memory had to be allocated
+     *  @var    size_t
+     */
+    size_t misses = 0;
+
+    /**
+     *  Number of destructed objects of which the memory was put in the pool
+     *  @var    size_t
+     */
+    size_t returns = 0;
+
+    /**
+     *  Number of blocks of memory that are in the pool right now
+     *  @var    size_t
+     */
+    size_t size = 0;
+};
+
+/**
+ *  End of namespace
+ */
+}
@@ -0,0 +1,606 @@
+/**
+ *  SmallVector.h
+ *
+ *  Vector-like container that stores the first N elements inside the
+ *  object itself, and only allocates memory on the heap when more elements
+ *  are added. This is used for the parameters of native functions: most
+ *  functions are called with a handful of arguments, and for those calls
+ *  no memory has to be allocated at all.
+ *
+ *  The interface is the same as the interface of std::vector (except for
+ *  allocators), so that code that was written for a vector also works with
+ *  this class. It is not a std::vector however, so it can not be passed to
+ *  a function that takes a reference to a vector. For such code the class
+ *  can be converted to a std::vector, which copies the elements.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2019 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Class definition
+ */
+template <typename T, size_t N>
+class SmallVector
+{
+public:
+    /**
+     *  Types, the same as those of std::vector
+     */
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = T*;
+    using const_iterator = const T*;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+private:
+    /**
+     *  Storage for the elements that are stored inside the object
+     *  @var    aligned_storage
+     */
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type _inline[N];
+
+    /**
+     *  Pointer to the elements (either the inline storage, or a heap buffer)
+     *  @var    T*
+     */
+    T *_data;
+
+    /**
+     *  Number of elements, and the number of elements that fit in the buffer
+     *  @var    size_t
+     */
+    size_t _size = 0;
+    size_t _capacity = N;
+
+    /**
+     *  Are the elements stored inline?
+     *  @return bool
+     */
+    bool isInline() const { return _data == reinterpret_cast<const T*>(_inline); }
+
+    /**
+     *  Move the elements to a buffer that can hold a number of elements
+     *  @param  capacity
+     */
+    void reallocate(size_t capacity)
+    {
+        // allocate the new buffer
+        T *buffer = static_cast<T*>(::operator new(capacity * sizeof(T)));
+
+        // move the elements, and destruct the originals
+        for (size_t i = 0; i < _size; ++i)
+        {
+            new (buffer + i) T(std::move(_data[i]));
+            _data[i].~T();
+        }
+
+        // the old buffer is no longer needed
+        if (!isInline()) ::operator delete(_data);
+
+        // use the new buffer
+        _data = buffer;
+        _capacity = capacity;
+    }
+
+    /**
+     *  Make room for one more element
+     */
+    void grow()
+    {
+        // double the capacity
+        reallocate(_capacity * 2);
+    }
+
+    /**
+     *  Move the elements of another vector into this empty vector
+     *  @param  that
+     */
+    void steal(SmallVector &that)
+    {
+        // heap buffers can be taken over as a whole
+        if (!that.isInline())
+        {
+            // take over the buffer
+            _data = that._data;
+            _size = that._size;
+            _capacity = that._capacity;
+
+            // the other vector is empty now
+            that._data = reinterpret_cast<T*>(that._inline);
+            that._size = 0;
+            that._capacity = N;
+        }
+        else
+        {
+            // inline elements have to be moved one by one
+            for (size_t i = 0; i < that._size; ++i) new (_data + i) T(std::move(that._data[i]));
+            _size = that._size;
+
+            // the other vector is empty now
+            that.clear();
+        }
+    }
+
+public:
+    /**
+     *  Constructor
+     */
+    SmallVector() : _data(reinterpret_cast<T*>(_inline)) {}
+
+    /**
+     *  Constructor with initial elements
+     *  @param  list
+     */
+    SmallVector(std::initializer_list<T> list) : SmallVector()
+    {
+        // copy the elements
+        reserve(list.size());
+        for (auto &element : list) new (_data + _size++) T(element);
+    }
+
+    /**
+     *  Copy constructor
+     *  @param  that
+     */
+    SmallVector(const SmallVector &that) : SmallVector()
+    {
+        // copy the elements
+        reserve(that._size);
+        for (auto &element : that) new (_data + _size++) T(element);
+    }
+
+    /**
+     *  Move constructor
+     *  @param  that
+     */
+    SmallVector(SmallVector &&that) _NOEXCEPT : SmallVector()
+    {
+        // take over the elements
+        steal(that);
+    }
+
+    /**
+     *  Destructor
+     */
+    ~SmallVector()
+    {
+        // destruct the elements
+        clear();
+
+        // deallocate the heap buffer
+        if (!isInline()) ::operator delete(_data);
+    }
+
+    /**
+     *  Assign another vector
+     *  @param  that
+     *  @return SmallVector
+     */
+    SmallVector &operator=(const SmallVector &that)
+    {
+        // skip self assignment
+        if (this == &that) return *this;
+
+        // copy the elements
+        clear();
+        reserve(that._size);
+        for (auto &element : that) new (_data + _size++) T(element);
+
+        // allow chaining
+        return *this;
+    }
+
+    /**
+     *  Move another vector
+     *  @param  that
+     *  @return SmallVector
+     */
+    SmallVector &operator=(SmallVector &&that) _NOEXCEPT
+    {
+        // skip self assignment
+        if (this == &that) return *this;
+
+        // forget the current elements and the heap buffer
+        clear();
+        if (!isInline()) ::operator delete(_data);
+        _data = reinterpret_cast<T*>(_inline);
+        _capacity = N;
+
+        // take over the elements
+        steal(that);
+
+        // allow chaining
+        return *this;
+    }
+
+    /**
+     *  Assign a list of elements
+     *  @param  list
+     *  @return SmallVector
+     */
+    SmallVector &operator=(std::initializer_list<T> list)
+    {
+        // replace the elements
+        assign(list);
+
+        // allow chaining
+        return *this;
+    }
+
+    /**
+     *  Replace the elements
+     *  @param  count       Number of elements
+     *  @param  value       Value of each element
+     */
+    void assign(size_t count, const T &value)
+    {
+        // the value may be one of our own elements, so copy it first
+        T copy(value);
+
+        // replace the elements
+        clear();
+        insert(end(), count, copy);
+    }
+
+    /**
+     *  Replace the elements with the elements in a range
+     *  @param  first
+     *  @param  last
+     */
+    template <typename InputIterator, typename = typename std::iterator_traits<InputIterator>::iterator_category>
+    void assign(InputIterator first, InputIterator last)
+    {
+        // replace the elements
+        clear();
+        insert(end(), first, last);
+    }
+
+    /**
+     *  Replace the elements with the elements in a list
+     *  @param  list
+     */
+    void assign(std::initializer_list<T> list) { assign(list.begin(), list.end()); }
+
+    /**
+     *  Swap the elements with another vector
+     *  @param  that
+     */
+    void swap(SmallVector &that)
+    {
+        // move the elements around
+        SmallVector other(std::move(that));
+        that = std::move(*this);
+        *this = std::move(other);
+    }
+
+    /**
+     *  Copy the elements into a std::vector, for code that needs a real vector
+     *  @return std::vector
+     */
+    operator std::vector<T>() const
+    {
+        return std::vector<T>(begin(), end());
+    }
+
+    /**
+     *  Size and capacity
+     *  @return size_t
+     */
+    size_t size() const { return _size; }
+    size_t capacity() const { return _capacity; }
+    size_t max_size() const { return size_t(-1) / sizeof(T); }
+    bool empty() const { return _size == 0; }
+
+    /**
+     *  Make sure that a number of elements fit in the buffer
+     *  @param  capacity
+     */
+    void reserve(size_t capacity)
+    {
+        // only grow
+        if (capacity > _capacity) reallocate(capacity);
+    }
+
+    /**
+     *  Give back the memory that is not used, elements that fit in the
+     *  object itself are moved back into it
+     */
+    void shrink_to_fit()
+    {
+        // nothing to give back if there is no heap buffer, or if it is full
+        if (isInline() || _size == _capacity) return;
+
+        // too many elements to store them inline
+        if (_size > N) return reallocate(_size);
+
+        // move the elements back into the object
+        T *buffer = _data;
+        _data = reinterpret_cast<T*>(_inline);
+        for (size_t i = 0; i < _size; ++i)
+        {
+            new (_data + i) T(std::move(buffer[i]));
+            buffer[i].~T();
+        }
+
+        // the heap buffer is no longer needed
+        ::operator delete(buffer);
+        _capacity = N;
+    }
+
+    /**
+     *  Change the number of elements
+     *  @param  size
+     */
+    void resize(size_t size)
+    {
+        // remove elements from the end
+        while (_size > size) pop_back();
+
+        // add default constructed elements
+        reserve(size);
+        while (_size < size) new (_data + _size++) T();
+    }
+
+    /**
+     *  Change the number of elements, new elements are copies of a value
+     *  @param  size
+     *  @param  value
+     */
+    void resize(size_t size, const T &value)
+    {
+        // remove elements from the end
+        while (_size > size) pop_back();
+
+        // add the new elements
+        if (_size < size) insert(end(), size - _size, value);
+    }
+
+    /**
+     *  Remove all elements
+     */
+    void clear()
+    {
+        // destruct the elements
+        for (size_t i = 0; i < _size; ++i) _data[i].~T();
+        _size = 0;
+    }
+
+    /**
+     *  Add an element to the end
+     *  @param  value
+     */
+    void push_back(const T &value) { emplace_back(value); }
+    void push_back(T &&value) { emplace_back(std::move(value)); }
+
+    /**
+     *  Construct an element at the end
+     *  @param  args
+     *  @return T
+     */
+    template <typename ...Args>
+    T &emplace_back(Args&&... args)
+    {
+        // construct the element in place if there is room
+        if (_size < _capacity) return *new (_data + _size++) T(std::forward<Args>(args)...);
+
+        // the arguments may refer to an element, so construct it before the buffer moves
+        T value(std::forward<Args>(args)...);
+        grow();
+        return *new (_data + _size++) T(std::move(value));
+    }
+
+    /**
+     *  Remove the last element
+     */
+    void pop_back()
+    {
+        // destruct the element
+        _data[--_size].~T();
+    }
+
+    /**
+     *  Insert an element
+     *  @param  position
+     *  @param  value
+     *  @return iterator
+     */
+    iterator insert(const_iterator position, T value)
+    {
+        // the index of the new element (the buffer may be reallocated)
+        size_t index = position - _data;
+
+        // add the element to the end, and rotate it into place
+        emplace_back(std::move(value));
+        std::rotate(_data + index, _data + _size - 1, _data + _size);
+
+        // expose the element
+        return _data + index;
+    }
+
+    /**
+     *  Insert a number of copies of an element
+     *  @param  position
+     *  @param  count
+     *  @param  value
+     *  @return iterator
+     */
+    iterator insert(const_iterator position, size_t count, const T &value)
+    {
+        // the index of the first new element, and the number of elements before the insert
+        size_t index = position - _data;
+        size_t size = _size;
+
+        // the value may be one of our own elements, so copy it before the buffer moves
+        T copy(value);
+
+        // add the elements to the end, and rotate them into place
+        reserve(_size + count);
+        for (size_t i = 0; i < count; ++i) new (_data + _size++) T(copy);
+        std::rotate(_data + index, _data + size, _data + _size);
+
+        // expose the first new element
+        return _data + index;
+    }
+
+    /**
+     *  Insert the elements in a range
+     *  @param  position
+     *  @param  first
+     *  @param  last
+     *  @return iterator
+     */
+    template <typename InputIterator, typename = typename std::iterator_traits<InputIterator>::iterator_category>
+    iterator insert(const_iterator position, InputIterator first, InputIterator last)
+    {
+        // the index of the first new element, and the number of elements before the insert
+        size_t index = position - _data;
+        size_t size = _size;
+
+        // add the elements to the end, and rotate them into place
+        for (; first != last; ++first) emplace_back(*first);
+        std::rotate(_data + index, _data + size, _data + _size);
+
+        // expose the first new element
+        return _data + index;
+    }
+
+    /**
+     *  Insert the elements in a list
+     *  @param  position
+     *  @param  list
+     *  @return iterator
+     */
+    iterator insert(const_iterator position, std::initializer_list<T> list) { return insert(position, list.begin(), list.end()); }
+
+    /**
+     *  Construct an element in place
+     *  @param  position
+     *  @param  args
+     *  @return iterator
+     */
+    template <typename ...Args>
+    iterator emplace(const_iterator position, Args&&... args)
+    {
+        // the index of the new element (the buffer may be reallocated)
+        size_t index = position - _data;
+
+        // add the element to the end, and rotate it into place
+        emplace_back(std::forward<Args>(args)...);
+        std::rotate(_data + index, _data + _size - 1, _data + _size);
+
+        // expose the element
+        return _data + index;
+    }
+
+    /**
+     *  Remove elements
+     *  @param  first
+     *  @param  last
+     *  @return iterator
+     */
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        // the range to remove
+        iterator from = _data + (first - _data);
+        iterator to = _data + (last - _data);
+
+        // move the other elements to the front, and remove the elements at the end
+        iterator end = std::move(to, _data + _size, from);
+        while (_data + _size > end) pop_back();
+
+        // expose the element after the removed range
+        return from;
+    }
+
+    /**
+     *  Remove an element
+     *  @param  position
+     *  @return iterator
+     */
+    iterator erase(const_iterator position) { return erase(position, position + 1); }
+
+    /**
+     *  Access to the elements
+     *  @param  index
+     *  @return T
+     */
+    T &operator[](size_t index) { return _data[index]; }
+    const T &operator[](size_t index) const { return _data[index]; }
+
+    /**
+     *  Access to the elements, with a range check
+     *  @param  index
+     *  @return T
+     */
+    T &at(size_t index) { if (index >= _size) throw std::out_of_range("SmallVector::at"); return _data[index]; }
+    const T &at(size_t index) const { if (index >= _size) throw std::out_of_range("SmallVector::at"); return _data[index]; }
+
+    /**
+     *  The first and last element
+     *  @return T
+     */
+    T &front() { return _data[0]; }
+    const T &front() const { return _data[0]; }
+    T &back() { return _data[_size - 1]; }
+    const T &back() const { return _data[_size - 1]; }
+
+    /**
+     *  Pointer to the elements
+     *  @return T*
+     */
+    T *data() { return _data; }
+    const T *data() const { return _data; }
+
+    /**
+     *  Iterators
+     *  @return iterator
+     */
+    iterator begin() { return _data; }
+    iterator end() { return _data + _size; }
+    const_iterator begin() const { return _data; }
+    const_iterator end() const { return _data + _size; }
+    const_iterator cbegin() const { return _data; }
+    const_iterator cend() const { return _data + _size; }
+    reverse_iterator rbegin() { return reverse_iterator(end()); }
+    reverse_iterator rend() { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crbegin() const { return const_reverse_iterator(end()); }
+    const_reverse_iterator crend() const { return const_reverse_iterator(begin()); }
+};
+
+/**
+ *  Comparison operators, just like the ones of std::vector
+ *  @param  a
+ *  @param  b
+ *  @return bool
+ */
+template <typename T, size_t N>
+bool operator==(const SmallVector<T,N> &a, const SmallVector<T,N> &b) { return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin()); }
+template <typename T, size_t N>
+bool operator!=(const SmallVector<T,N> &a, const SmallVector<T,N> &b) { return !(a == b); }
+template <typename T, size_t N>
+bool operator< (const SmallVector<T,N> &a, const SmallVector<T,N> &b) { return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end()); }
+template <typename T, size_t N>
+bool operator> (const SmallVector<T,N> &a, const SmallVector<T,N> &b) { return b < a; }
+template <typename T, size_t N>
+bool operator<=(const SmallVector<T,N> &a, const SmallVector<T,N> &b) { return !(b < a); }
+template <typename T, size_t N>
+bool operator>=(const SmallVector<T,N> &a, const SmallVector<T,N> &b) { return !(a < b); }
+
+/**
+ *  End of namespace
+ */
+}
@@ -0,0 +1,149 @@
+/**
+ *  StringBuilder.h
+ *
+ *  Class to build a (possibly very big) string that is going to be passed
+ *  to PHP space. The builder writes directly into a buffer that is allocated
+ *  by the Zend engine, and when the string is complete, this buffer is handed
+ *  over to a Php::Value without copying it.
+ *
+ *  This is the recommended way to return big rendered documents from C++,
+ *  because a std::string would have to be copied into a zval at the end.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2019 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Class definition
+ */
+class PHPCPP_EXPORT StringBuilder
+{
+public:
+    /**
+     *  Constructor
+     */
+    StringBuilder() {}
+
+    /**
+     *  Constructor that immediately allocates a buffer
+     *  @param  capacity    The expected size of the string
+     */
+    explicit StringBuilder(size_t capacity);
+
+    /**
+     *  The builder can not be copied, because it owns the buffer
+     *  @param  that
+     */
+    StringBuilder(const StringBuilder &that) = delete;
+
+    /**
+     *  Move constructor
+     *  @param  that
+     */
+    StringBuilder(StringBuilder &&that) _NOEXCEPT;
+
+    /**
+     *  Destructor
+     */
+    ~StringBuilder();
+
+    /**
+     *  Append data to the string
+     *  @param  data        The data to append
+     *  @param  size        Size of the data
+     *  @return StringBuilder
+     */
+    StringBuilder &append(const char *data, size_t size);
+    StringBuilder &append(const char *data) { return append(data, ::strlen(data)); }
+    StringBuilder &append(const std::string &data) { return append(data.data(), data.size()); }
+    StringBuilder &append(const StringView &data) { return append(data.data(), data.size()); }
+    StringBuilder &append(char data) { return append(&data, 1); }
+
+    /**
+     *  Stream operators to append data
+     *  @param  data
+     *  @return StringBuilder
+     */
+    StringBuilder &operator<<(const char *data) { return append(data); }
+    StringBuilder &operator<<(const std::string &data) { return append(data); }
+    StringBuilder &operator<<(const StringView &data) { return append(data); }
+    StringBuilder &operator<<(char data) { return append(data); }
+
+    /**
+     *  Make sure that a number of bytes can be appended to the string without
+     *  a reallocation, and get access to the buffer where these bytes should
+     *  be written to. After you have written the data, you must call the
+     *  advance() method to tell the builder how much data you wrote.
+     *
+     *  @param  size        Number of bytes that you are going to write
+     *  @return char*       Pointer where you can write
+     */
+    char *reserve(size_t size);
+
+    /**
+     *  Tell the builder that data was written to the buffer returned by reserve()
+     *  @param  size        Number of bytes that were written
+     */
+    void advance(size_t size) { _size += size; }
+
+    /**
+     *  The current size of the string
+     *  @return size_t
+     */
+    size_t size() const { return _size; }
+
+    /**
+     *  The number of bytes that can be stored without reallocating
+     *  @return size_t
+     */
+    size_t capacity() const { return _capacity; }
+
+    /**
+     *  Access to the data that was written so far
+     *  @return const char *
+     */
+    const char *data() const { return _buffer; }
+
+    /**
+     *  Empty the string (the buffer is kept)
+     */
+    void clear() { _size = 0; }
+
+    /**
+     *  Hand over the buffer to a Php::Value. The buffer is not copied, but
+     *  becomes the string buffer of the zval. After this call, the builder
+     *  is empty again.
+     *
+     *  @return Value
+     */
+    Value value();
+
+private:
+    /**
+     *  The buffer, allocated with emalloc()
+     *  @var char*
+     */
+    char *_buffer = nullptr;
+
+    /**
+     *  Number of bytes in use
+     *  @var size_t
+     */
+    size_t _size = 0;
+
+    /**
+     *  Number of bytes allocated (not including the space for the terminating null)
+     *  @var size_t
+     */
+    size_t _capacity = 0;
+};
+
+/**
+ *  End of namespace
+ */
+}
@@ -0,0 +1,152 @@
+/**
+ *  StringView.h
+ *
+ *  A string view is a borrowed pointer to a buffer plus its size. It is
+ *  returned by Value::stringView() and gives access to the string data that
+ *  is stored inside a zval without copying it into a std::string.
+ *
+ *  The view does not own the buffer. It is only valid for as long as the
+ *  value from which it was retrieved is alive and is not modified.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2019 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Class definition
+ */
+class PHPCPP_EXPORT StringView
+{
+public:
+    /**
+     *  Constructor for an empty view
+     */
+    StringView() {}
+
+    /**
+     *  Constructor
+     *  @param  data        Pointer to the buffer
+     *  @param  size        Size of the buffer
+     */
+    StringView(const char *data, size_t size) : _data(data), _size(size) {}
+
+    /**
+     *  Constructor from a null-terminated string
+     *  @param  data
+     */
+    explicit StringView(const char *data) : _data(data), _size(data ? ::strlen(data) : 0) {}
+
+    /**
+     *  Constructor from a std::string (the view refers to the buffer of the string)
+     *  @param  data
+     */
+    explicit StringView(const std::string &data) : _data(data.data()), _size(data.size()) {}
+
+    /**
+     *  Pointer to the buffer (this is nullptr for an empty view)
+     *  @return const char *
+     */
+    const char *data() const { return _data; }
+
+    /**
+     *  Size of the buffer
+     *  @return size_t
+     */
+    size_t size() const { return _size; }
+
+    /**
+     *  Size of the buffer
+     *  @return size_t
+     */
+    size_t length() const { return _size; }
+
+    /**
+     *  Is the view empty?
+     *  @return bool
+     */
+    bool empty() const { return _size == 0; }
+
+    /**
+     *  Iterators to the begin and end of the buffer
+     *  @return const char *
+     */
+    const char *begin() const { return _data; }
+    const char *end() const { return _data + _size; }
+
+    /**
+     *  Access to a single character
+     *  @param  index
+     *  @return char
+     */
+    char operator[](size_t index) const { return _data[index]; }
+
+    /**
+     *  Compare with a different view
+     *  @param  that
+     *  @return int
+     */
+    int compare(const StringView &that) const
+    {
+        // compare the common part
+        int result = ::memcmp(_data, that._data, _size < that._size ? _size : that._size);
+
+        // the shortest string comes first if the common part is identical
+        if (result != 0) return result;
+        return _size < that._size ? -1 : _size > that._size ? 1 : 0;
+    }
+
+    /**
+     *  Comparison operators
+     *  @param  that
+     *  @return bool
+     */
+    bool operator==(const StringView &that) const { return _size == that._size && ::memcmp(_data, that._data, _size) == 0; }
+    bool operator!=(const StringView &that) const { return !operator==(that); }
+    bool operator< (const StringView &that) const { return compare(that) <  0; }
+    bool operator> (const StringView &that) const { return compare(that) >  0; }
+    bool operator<=(const StringView &that) const { return compare(that) <= 0; }
+    bool operator>=(const StringView &that) const { return compare(that) >= 0; }
+
+    /**
+     *  Copy the data into a std::string
+     *  @return std::string
+     */
+    std::string str() const { return std::string(_data, _size); }
+
+    /**
+     *  Cast to a std::string (this makes a copy)
+     *  @return std::string
+     */
+    operator std::string () const { return str(); }
+
+private:
+    /**
+     *  The borrowed buffer
+     *  @var const char *
+     */
+    const char *_data = nullptr;
+
+    /**
+     *  Size of the buffer
+     *  @var size_t
+     */
+    size_t _size = 0;
+};
+
+/**
+ *  Custom output stream operator
+ *  @param  stream
+ *  @param  value
+ *  @return ostream
+ */
+PHPCPP_EXPORT std::ostream &operator<<(std::ostream &stream, const StringView &value);
+
+/**
+ *  End of namespace
+ */
+}
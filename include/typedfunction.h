@@ -0,0 +1,311 @@
+/**
+ *  TypedFunction.h
+ *
+ *  Native functions with a plain C++ signature. Instead of receiving a
+ *  Parameters object and converting each Value by hand, such a function
+ *  takes its arguments as C++ types, and returns a C++ type:
+ *
+ *      int64_t scale(double factor, Php::StringView unit, const Php::Array &values);
+ *
+ *      extension.add<decltype(&scale), &scale>("scale");
+ *
+ *  (with C++17 this can be written as extension.add<&scale>("scale")).
+ *
+ *  The arguments are read straight from the PHP stack, without creating
+ *  a Parameters object, and they are converted with the same rules that
+ *  PHP uses for its own builtin functions: a string like "12" is accepted
+ *  for an integer parameter, but an array is not. When an argument can not
+ *  be converted, the function is not called: a warning is reported and the
+ *  call returns null, just like a builtin PHP function does. The return
+ *  value is also written straight into the PHP return value.
+ *
+ *  Supported argument types are bool, all integral and floating point
+ *  types, std::string, Php::StringView (which refers to the string on the
+ *  PHP stack, so it is only valid during the call), Php::ValueRef, and
+ *  Php::Value, Php::Array and Php::Object (by value or by const reference).
+ *  The same types can be returned, except Php::ValueRef.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2019 Copernica BV
+ */
+
+/**
+ *  Forward declarations
+ */
+struct _zval_struct;
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Base class with the parts of the typed functions that do not depend on
+ *  the signature. This is an internal class that is used by the templates
+ *  below, it is not meant to be used by extension writers.
+ */
+class PHPCPP_EXPORT TypedFunctionBase
+{
+public:
+    /**
+     *  Check the number of arguments
+     *
+     *  If this function returns false a warning will have been generated
+     *  and the return value has been set to NULL.
+     *
+     *  @param  provided        The number of arguments provided
+     *  @param  expected        The number of arguments of the function
+     *  @param  return_value    The return value to set on failure
+     *  @return bool
+     */
+    static bool count(int provided, int expected, struct _zval_struct *return_value);
+
+    /**
+     *  Get the arguments from the PHP stack
+     *  @param  provided        The number of arguments provided
+     *  @return                 Pointer to the first argument
+     */
+    static struct _zval_struct **arguments(int provided);
+
+    /**
+     *  Convert an argument into a C++ type. These functions return false
+     *  (and report a warning) if the argument can not be converted.
+     *
+     *  @param  argument        Pointer to the argument on the stack
+     *  @param  index           Index of the argument
+     *  @param  result          Variable to store the result in
+     *  @return bool
+     */
+    static bool decode(struct _zval_struct **argument, int index, bool &result);
+    static bool decode(struct _zval_struct **argument, int index, int64_t &result);
+    static bool decode(struct _zval_struct **argument, int index, double &result);
+    static bool decode(struct _zval_struct **argument, int index, std::string &result);
+    static bool decode(struct _zval_struct **argument, int index, StringView &result);
+    static bool decode(struct _zval_struct **argument, int index, struct _zval_struct *&result);
+    static bool decode(struct _zval_struct **argument, int index, Value &result);
+    static bool decode(struct _zval_struct **argument, int index, Value &result, Type type);
+
+    /**
+     *  Set the function to return null because the arguments were invalid
+     *  @param  return_value
+     */
+    static void invalid(struct _zval_struct *return_value);
+
+    /**
+     *  Store the return value
+     *  @param  return_value
+     *  @param  value
+     */
+    static void encode(struct _zval_struct *return_value, std::nullptr_t value);
+    static void encode(struct _zval_struct *return_value, bool value);
+    static void encode(struct _zval_struct *return_value, int64_t value);
+    static void encode(struct _zval_struct *return_value, double value);
+    static void encode(struct _zval_struct *return_value, const std::string &value);
+    static void encode(struct _zval_struct *return_value, const StringView &value);
+    static void encode(struct _zval_struct *return_value, Value &&value);
+
+    /**
+     *  Handle exceptions
+     *  @param  exception
+     */
+    static void handle(Throwable &exception);
+};
+
+/**
+ *  How a C++ type is read from an argument. The "type" is the variable
+ *  that the argument is decoded into, and get() turns that variable into
+ *  something that can be passed to the function.
+ */
+template <typename T, typename = void>
+struct TypedValue;
+
+template <>
+struct TypedValue<bool>
+{
+    using type = bool;
+    static bool decode(struct _zval_struct **argument, int index, type &result) { return TypedFunctionBase::decode(argument, index, result); }
+    static bool get(type value) { return value; }
+};
+
+template <typename T>
+struct TypedValue<T, typename std::enable_if<std::is_integral<T>::value>::type>
+{
+    using type = int64_t;
+    static bool decode(struct _zval_struct **argument, int index, type &result) { return TypedFunctionBase::decode(argument, index, result); }
+    static T get(type value) { return static_cast<T>(value); }
+};
+
+template <typename T>
+struct TypedValue<T, typename std::enable_if<std::is_floating_point<T>::value>::type>
+{
+    using type = double;
+    static bool decode(struct _zval_struct **argument, int index, type &result) { return TypedFunctionBase::decode(argument, index, result); }
+    static T get(type value) { return static_cast<T>(value); }
+};
+
+template <>
+struct TypedValue<std::string>
+{
+    using type = std::string;
+    static bool decode(struct _zval_struct **argument, int index, type &result) { return TypedFunctionBase::decode(argument, index, result); }
+    static std::string &get(type &value) { return value; }
+};
+
+template <>
+struct TypedValue<StringView>
+{
+    using type = StringView;
+    static bool decode(struct _zval_struct **argument, int index, type &result) { return TypedFunctionBase::decode(argument, index, result); }
+    static const StringView &get(const type &value) { return value; }
+};
+
+template <>
+struct TypedValue<ValueRef>
+{
+    using type = struct _zval_struct *;
+    static bool decode(struct _zval_struct **argument, int index, type &result) { return TypedFunctionBase::decode(argument, index, result); }
+    static ValueRef get(type value) { return ValueRef(value); }
+};
+
+template <>
+struct TypedValue<Value>
+{
+    using type = Value;
+    static bool decode(struct _zval_struct **argument, int index, type &result) { return TypedFunctionBase::decode(argument, index, result); }
+    static Value &get(type &value) { return value; }
+};
+
+template <>
+struct TypedValue<Array>
+{
+    using type = Value;
+    static bool decode(struct _zval_struct **argument, int index, type &result) { return TypedFunctionBase::decode(argument, index, result, Type::Array); }
+    static Array get(type &value) { return Array(std::move(value)); }
+};
+
+template <>
+struct TypedValue<Object>
+{
+    using type = Value;
+    static bool decode(struct _zval_struct **argument, int index, type &result) { return TypedFunctionBase::decode(argument, index, result, Type::Object); }
+    static Object get(type &value) { return Object(value); }
+};
+
+/**
+ *  Helper to expand the arguments of a function (std::index_sequence is
+ *  only available since C++14)
+ */
+template <size_t ...I>
+struct IndexSequence {};
+
+template <size_t N, size_t ...I>
+struct MakeIndexSequence : MakeIndexSequence<N - 1, N - 1, I...> {};
+
+template <size_t ...I>
+struct MakeIndexSequence<0, I...> { using type = IndexSequence<I...>; };
+
+/**
+ *  The signatures that take a Parameters object, these are registered the
+ *  old way and not as a typed function
+ */
+template <typename F> struct IsParametersFunction : std::false_type {};
+template <> struct IsParametersFunction<void(*)()> : std::true_type {};
+template <> struct IsParametersFunction<void(*)(Parameters &)> : std::true_type {};
+template <> struct IsParametersFunction<Value(*)()> : std::true_type {};
+template <> struct IsParametersFunction<Value(*)(Parameters &)> : std::true_type {};
+
+/**
+ *  Class definition
+ */
+template <typename F, F callback>
+class TypedFunction;
+
+/**
+ *  Specialization for functions
+ */
+template <typename R, typename ...Args, R(*callback)(Args...)>
+class TypedFunction<R(*)(Args...), callback> : private TypedFunctionBase
+{
+private:
+    /**
+     *  Call a function that returns nothing
+     *  @param  return_value
+     *  @param  values
+     */
+    template <typename ...Values>
+    static void execute(std::true_type, struct _zval_struct *return_value, Values&&... values)
+    {
+        // call the function, and return null
+        callback(std::forward<Values>(values)...);
+        encode(return_value, nullptr);
+    }
+
+    /**
+     *  Call a function that returns something
+     *  @param  return_value
+     *  @param  values
+     */
+    template <typename ...Values>
+    static void execute(std::false_type, struct _zval_struct *return_value, Values&&... values)
+    {
+        // call the function, and store the result
+        encode(return_value, static_cast<typename TypedValue<typename std::decay<R>::type>::type>(callback(std::forward<Values>(values)...)));
+    }
+
+    /**
+     *  Decode the arguments and call the function
+     *  @param  provided
+     *  @param  return_value
+     */
+    template <size_t ...I>
+    static void call(int provided, struct _zval_struct *return_value, IndexSequence<I...>)
+    {
+        // check the number of arguments
+        if (!count(provided, sizeof...(Args), return_value)) return;
+
+        // the arguments on the stack
+        struct _zval_struct **input = arguments(provided);
+
+        // variables to decode the arguments into
+        std::tuple<typename TypedValue<typename std::decay<Args>::type>::type...> values;
+
+        // decode the arguments from left to right, and stop at the first failure
+        bool valid = true;
+        (void)std::initializer_list<bool>{ (valid = valid && TypedValue<typename std::decay<Args>::type>::decode(input + I, I, std::get<I>(values)))... };
+
+        // do not call the function if one of the arguments was wrong
+        if (!valid) return invalid(return_value);
+
+        // catch exceptions thrown by the C++ function
+        try
+        {
+            // call the function
+            execute(typename std::is_void<R>::type(), return_value, TypedValue<typename std::decay<Args>::type>::get(std::get<I>(values))...);
+        }
+        catch (Throwable &exception)
+        {
+            // handle the exception
+            handle(exception);
+        }
+    }
+
+public:
+    /**
+     *  Execute the callback
+     *  @param  ht                  Number of parameters passed by the user
+     *  @param  return_value        Store the return value here
+     *  @param  return_value_ptr    Another pointer to the return value
+     *  @param  this_ptr            Pointer to "this" (the object the method is called on)
+     *  @param  return_value_used   1 if the return value is used, 0 if not
+     */
+    static void invoke(int ht, struct _zval_struct *return_value, struct _zval_struct **return_value_ptr, struct _zval_struct *this_ptr, int return_value_used)
+    {
+        // decode the arguments, and call the function
+        call(ht, return_value, typename MakeIndexSequence<sizeof...(Args)>::type());
+    }
+};
+
+/**
+ *  End of namespace
+ */
+}
@@ -32,6 +32,8 @@ namespace Php {
  *  Forward definitions
  */
 class Base;
+class LocalValue;
+class ValueRef;
 class ValueIterator;
 class Parameters;
 template <class Type> class HashMember;
@@ -75,6 +77,9 @@ public:
     template <typename T>
     Value(const std::vector<T> &input) : Value(Type::Array)
     {
+        // allocate the hash table at its final size
+        reserveArray(input.size());
+
         // index
         int i = 0;
 
@@ -92,6 +97,9 @@ public:
     template <typename T>
     Value(const std::initializer_list<T> &value) : Value(Type::Array)
     {
+        // allocate the hash table at its final size
+        reserveArray(value.size());
+
         // index
         int i = 0;
 
@@ -109,10 +117,50 @@ public:
     template <typename T>
     Value(const std::map<std::string,T> &value) : Value(Type::Array)
     {
+        // allocate the hash table at its final size
+        reserveArray(value.size());
+
         // set all elements
         for (auto &iter : value) setRaw(iter.first.c_str(), iter.first.size(), iter.second);
     }
 
+    /**
+     *  Constructor from an unordered map (this will create an array that
+     *  can have both numeric and string keys)
+     *  @param  value
+     */
+    template <typename T>
+    Value(const std::unordered_map<Key,T> &value) : Value(Type::Array)
+    {
+        // allocate the hash table at its final size
+        reserveArray(value.size());
+
+        // set all elements
+        for (auto &iter : value) setRaw(iter.first, iter.second);
+    }
+
+    /**
+     *  Constructor from a vector of key-value pairs (this will create an
+     *  array that can have both numeric and string keys)
+     *  @param  value
+     */
+    template <typename T>
+    Value(const std::vector<std::pair<Key,T>> &value) : Value(Type::Array)
+    {
+        // allocate the hash table at its final size
+        reserveArray(value.size());
+
+        // set all elements
+        for (auto &iter : value) setRaw(iter.first, iter.second);
+    }
+
+    /**
+     *  Constructor from a local value, this moves the inline zval from
+     *  the local value to the heap
+     *  @param  value
+     */
+    Value(const LocalValue &value);
+
     /**
      *  Wrap object around zval
      *  @param  zval        Zval to wrap
@@ -167,6 +215,8 @@ public:
     Value &operator=(double value);
     Value &operator=(const HashMember<std::string> &value);
     Value &operator=(const HashMember<int> &value);
+    Value &operator=(const HashMember<Key> &value);
+    Value &operator=(const LocalValue &value);
 
     /**
      *  Add a value to the object
@@ -329,6 +379,18 @@ public:
     bool operator< (const char *value) const { return ::strcmp(rawValue(), value) <  0; }
     bool operator> (const char *value) const { return ::strcmp(rawValue(), value) >  0; }
 
+    /**
+     *  Comparison operators for strings, these do not copy the value
+     *  into a temporary std::string if the value already is a string
+     *  @param  value
+     */
+    bool operator==(const std::string &value) const { return compare(value) == 0; }
+    bool operator!=(const std::string &value) const { return compare(value) != 0; }
+    bool operator<=(const std::string &value) const { return compare(value) <= 0; }
+    bool operator>=(const std::string &value) const { return compare(value) >= 0; }
+    bool operator< (const std::string &value) const { return compare(value) <  0; }
+    bool operator> (const std::string &value) const { return compare(value) >  0; }
+
     /**
      *  Comparison operators for hardcoded Value
      *  @param  value
@@ -422,6 +484,16 @@ public:
      */
     const char *rawValue() const;
 
+    /**
+     *  Get a borrowed view on the string buffer, without copying it. Note
+     *  that this only works for string variables - other variables return
+     *  an empty view. The view is only valid for as long as the value is
+     *  not modified or destructed.
+     *
+     *  @return StringView
+     */
+    StringView stringView() const;
+
     /**
      *  Retrieve the value as number
      *
@@ -527,6 +599,21 @@ public:
      */
     std::map<std::string,Php::Value> mapValue() const;
 
+    /**
+     *  Convert the object to an unordered map. Different from mapValue(), the
+     *  numeric keys are not converted into strings
+     *  @return std::unordered_map
+     */
+    std::unordered_map<Key,Php::Value> unorderedMapValue() const;
+
+    /**
+     *  Convert the object to a vector of key-value pairs, sorted by key (the
+     *  numeric keys come first). Lookups in this vector can be done with a
+     *  binary search.
+     *  @return std::vector
+     */
+    std::vector<std::pair<Key,Php::Value>> flatMapValue() const;
+
     /**
      *  Convert the object to a map with string index and a specific type as value
      *  @return std::map
@@ -646,6 +733,13 @@ public:
         return contains(value.stringValue());
     }
 
+    /**
+     *  Is a certain key set in the array, using the precomputed hash of the key
+     *  @param  key
+     *  @return bool
+     */
+    virtual bool contains(const Key &key) const override;
+
     /**
      *  Cast to a number
      *  @return int32_t
@@ -789,6 +883,13 @@ public:
         return get(key.stringValue());
     }
 
+    /**
+     *  Get access to a member, using the precomputed hash of the key
+     *  @param  key
+     *  @return Value
+     */
+    virtual Value get(const Key &key) const override;
+
     /**
      *  Set a certain property
      *  Calling this method will turn the value into an array
@@ -841,6 +942,14 @@ public:
         return set(key.stringValue(), value);
     }
 
+    /**
+     *  Overwrite the value at a certain key, using the precomputed hash of the key
+     *  Calling this method will turn the value into an array
+     *  @param  key
+     *  @param  value
+     */
+    virtual void set(const Key &key, const Value &value) override;
+
     /**
      *  Unset a member by its index
      *  @param  index
@@ -884,6 +993,12 @@ public:
         return unset(key.stringValue());
     }
 
+    /**
+     *  Unset a member, using the precomputed hash of the key
+     *  @param  key
+     */
+    virtual void unset(const Key &key) override;
+
     /**
      *  Array access operator
      *  This can be used for accessing arrays
@@ -960,6 +1075,23 @@ public:
         return get(key.stringValue());
     }
 
+    /**
+     *  Index by a key with a precomputed hash
+     *  @param  key
+     *  @return HashMember<Key>
+     */
+    HashMember<Key> operator[](const Key &key);
+
+    /**
+     *  Index by a key with a precomputed hash
+     *  @param  key
+     *  @return Value
+     */
+    Value operator[](const Key &key) const
+    {
+        return get(key);
+    }
+
     /**
      *  Call the function in PHP
      *  This call operator is only useful when the variable represents a callable
@@ -1102,6 +1234,38 @@ public:
     bool derivedFrom(const char *classname, bool allowString = false) const { return derivedFrom(classname, strlen(classname), allowString); }
     bool derivedFrom(const std::string &classname, bool allowString = false) const { return derivedFrom(classname.c_str(), classname.size(), allowString); }
 
+    /**
+     *  Visit all elements of an array or object
+     *
+     *  The visitor is called with a borrowed key and value for every element,
+     *  for arrays these come straight from the hash table, so iterating does
+     *  not allocate anything and does not touch any reference counters. The
+     *  visitor must be callable with both a numeric and a string key:
+     *
+     *      struct Visitor
+     *      {
+     *          void operator()(int64_t key, const Php::ValueRef &value) { ... }
+     *          void operator()(const Php::StringView &key, const Php::ValueRef &value) { ... }
+     *      };
+     *
+     *  The array should not be modified while it is visited.
+     *
+     *  @param  visitor
+     */
+    template <typename Visitor>
+    void forEach(Visitor &&visitor) const
+    {
+        // the actual type of the visitor
+        typedef typename std::remove_reference<Visitor>::type V;
+
+        // pass on the visitor with a callback for numeric and for string keys
+        forEach(
+            [](void *data, int64_t key, const ValueRef &value) { (*static_cast<V*>(data))(key, value); },
+            [](void *data, const StringView &key, const ValueRef &value) { (*static_cast<V*>(data))(key, value); },
+            (void *)&visitor
+        );
+    }
+
 
 private:
     /**
@@ -1110,6 +1274,14 @@ private:
      */
     void iterate(const std::function<void(const Php::Value &,const Php::Value &)> &callback) const;
 
+    /**
+     *  Visit all elements of an array or object
+     *  @param  numeric     Callback for elements with a numeric key
+     *  @param  string      Callback for elements with a string key
+     *  @param  data        The visitor that is passed to the callbacks
+     */
+    void forEach(void (*numeric)(void *data, int64_t key, const ValueRef &value), void (*string)(void *data, const StringView &key, const ValueRef &value), void *data) const;
+
     /**
      *  Call function with a number of parameters
      *  @param  argc        Number of parameters
@@ -1155,6 +1327,19 @@ protected:
      */
     struct _zval_struct *detach(bool keeprefcount = true);
 
+    /**
+     *  Move the value into the return value of a function
+     *
+     *  When this object is the only owner of the variable, the contents are
+     *  moved into the return value, so that strings and arrays do not have to
+     *  be copied. Otherwise the return value shares or copies the variable.
+     *  Afterwards the object is detached, like after a call to detach().
+     *
+     *  @param  return_value        The return value
+     *  @param  return_value_ptr    Pointer to the return value (may be nullptr)
+     */
+    void moveTo(struct _zval_struct *return_value, struct _zval_struct **return_value_ptr = nullptr);
+
     /**
      *  Set a certain property without running any checks (you must already know
      *  for sure that this is an array, and that the index is not yet in use)
@@ -1175,6 +1360,33 @@ protected:
      */
     void setRaw(const char *key, int size, const Value &value);
 
+    /**
+     *  Set a certain property without any checks, using the precomputed hash
+     *  of the key (you must already know for sure that this is either an
+     *  object or an array)
+     *
+     *  @param  key         Key of the property to set
+     *  @param  value       Value to set
+     */
+    void setRaw(const Key &key, const Value &value);
+
+    /**
+     *  Turn the value into an array that has room for a certain number of
+     *  elements, so that the hash table does not have to grow while it is
+     *  being filled. Zend has no API to grow a table that is already
+     *  filled, so this only has effect when the array is still empty.
+     *
+     *  @param  size        Expected number of elements
+     */
+    void reserveArray(size_t size);
+
+    /**
+     *  Compare the value with a string, the same way as std::string::compare()
+     *  @param  value
+     *  @return int
+     */
+    int compare(const std::string &value) const;
+
     /**
      *  Internal helper method to create an `
      *  @param  begin       Should the iterator start at the begin?
@@ -1207,11 +1419,21 @@ protected:
     friend class TraverseIterator;
     friend class HashMember<int>;
     friend class HashMember<std::string>;
+    friend class HashMember<Key>;
     friend class Callable;
     friend class ZendCallable;
+    friend class TypedFunctionBase;
     friend class Script;
     friend class ConstantImpl;
     friend class Stream;
+    friend class ArrayBuilder;
+    friend class CallSite;
+    friend class ValueRef;
+    friend class BinaryEncoder;
+    friend class BinaryDecoder;
+    template <typename Output> friend class JsonEncoder;
+    template <typename Input> friend class JsonDecoder;
+    template <template<typename T> class F> friend class Arithmetic;
 
     /**
      *  Friend functions which have to access that zval directly
@@ -1220,6 +1442,27 @@ protected:
     friend Value set_error_handler(const std::function<Value(Parameters &params)> &handler, Message message);
 };
 
+/**
+ *  Specializations of vectorValue() for the most common types, these read
+ *  the values straight from the hash table, without wrapping each element
+ *  in a Value object first
+ *  @return std::vector
+ */
+template <> std::vector<int64_t> Value::vectorValue<int64_t>() const;
+template <> std::vector<double> Value::vectorValue<double>() const;
+template <> std::vector<bool> Value::vectorValue<bool>() const;
+template <> std::vector<std::string> Value::vectorValue<std::string>() const;
+
+/**
+ *  Specializations of mapValue() for the most common types, that also skip
+ *  the intermediate Value objects
+ *  @return std::map
+ */
+template <> std::map<std::string,int64_t> Value::mapValue<int64_t>() const;
+template <> std::map<std::string,double> Value::mapValue<double>() const;
+template <> std::map<std::string,bool> Value::mapValue<bool>() const;
+template <> std::map<std::string,std::string> Value::mapValue<std::string>() const;
+
 /**
  *  Custom output stream operator
  *  @param  stream
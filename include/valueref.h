@@ -0,0 +1,203 @@
+/**
+ *  ValueRef.h
+ *
+ *  A ValueRef is a borrowed, read-only reference to a PHP variable. Unlike
+ *  a Php::Value it does not own the variable: creating and destructing a
+ *  ValueRef does not touch the reference counter of the variable, and it
+ *  does not allocate anything.
+ *
+ *  This also means that a ValueRef is only valid as long as the variable
+ *  that it refers to exists: it should not be stored or returned. If you
+ *  need to keep the variable, turn it into a Php::Value with the value()
+ *  method.
+ *
+ *  Nested lookups also return a ValueRef, so reading deep into an array
+ *  does not change any reference counters either:
+ *
+ *      Php::ValueRef config(params[0]);
+ *      int64_t port = config["server"]["port"].numericValue();
+ *
+ *  Members that do not exist are returned as a reference to null. Lookups
+ *  in objects only read the public properties (the ArrayAccess interface
+ *  is not used, because that would require calling PHP code).
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2019 Copernica BV
+ */
+
+/**
+ *  Forward definitions
+ */
+struct _zval_struct;
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Class definition
+ */
+class PHPCPP_EXPORT ValueRef
+{
+public:
+    /**
+     *  Constructor
+     *  @param  zval        The variable to refer to
+     */
+    explicit ValueRef(struct _zval_struct *zval) : _val(zval) {}
+
+    /**
+     *  Constructor to refer to the variable held by a Php::Value
+     *  @param  value       The value to refer to
+     */
+    explicit ValueRef(const Value &value);
+
+    /**
+     *  Destructor
+     */
+    ~ValueRef() {}
+
+    /**
+     *  The type of the variable
+     *  @return Type
+     */
+    Type type() const;
+
+    /**
+     *  Check if the value is of a certain type
+     *  @return bool
+     */
+    bool isNull()       const { return type() == Type::Null; }
+    bool isNumeric()    const { return type() == Type::Numeric; }
+    bool isBool()       const { return type() == Type::Bool; }
+    bool isString()     const { return type() == Type::String; }
+    bool isFloat()      const { return type() == Type::Float; }
+    bool isObject()     const { return type() == Type::Object; }
+    bool isArray()      const { return type() == Type::Array; }
+    bool isScalar()     const { return isNull() || isNumeric() || isBool() || isString() || isFloat(); }
+
+    /**
+     *  Retrieve the value as number
+     *  @return int64_t
+     */
+    int64_t numericValue() const;
+
+    /**
+     *  Retrieve the value as boolean
+     *  @return bool
+     */
+    bool boolValue() const;
+
+    /**
+     *  Retrieve the value as a string
+     *  @return std::string
+     */
+    std::string stringValue() const;
+
+    /**
+     *  Get a borrowed view on the string buffer. Note that this only works
+     *  for string variables - other variables return an empty view.
+     *  @return StringView
+     */
+    StringView stringView() const;
+
+    /**
+     *  Retrieve the value as decimal
+     *  @return double
+     */
+    double floatValue() const;
+
+    /**
+     *  The number of elements in the array, or the length of the string
+     *  @return int
+     */
+    int size() const;
+
+    /**
+     *  Is a certain index or key set in the array or object?
+     *  @param  index
+     *  @param  key
+     *  @return bool
+     */
+    bool contains(int index) const;
+    bool contains(const char *key, int size) const;
+    bool contains(const char *key) const { return contains(key, ::strlen(key)); }
+    bool contains(const std::string &key) const { return contains(key.c_str(), key.size()); }
+    bool contains(const Key &key) const;
+
+    /**
+     *  Get access to a member of the array or object (a reference to null
+     *  is returned when the member does not exist)
+     *  @param  index
+     *  @param  key
+     *  @return ValueRef
+     */
+    ValueRef get(int index) const;
+    ValueRef get(const char *key, int size) const;
+    ValueRef get(const char *key) const { return get(key, ::strlen(key)); }
+    ValueRef get(const std::string &key) const { return get(key.c_str(), key.size()); }
+    ValueRef get(const Key &key) const;
+
+    /**
+     *  Array access operators
+     *  @param  index
+     *  @param  key
+     *  @return ValueRef
+     */
+    ValueRef operator[](int index) const { return get(index); }
+    ValueRef operator[](const char *key) const { return get(key); }
+    ValueRef operator[](const std::string &key) const { return get(key); }
+    ValueRef operator[](const Key &key) const { return get(key); }
+
+    /**
+     *  Visit all elements of the array or object, this works exactly like
+     *  Value::forEach()
+     *  @param  visitor
+     */
+    template <typename Visitor>
+    void forEach(Visitor &&visitor) const
+    {
+        // the actual type of the visitor
+        typedef typename std::remove_reference<Visitor>::type V;
+
+        // pass on the visitor with a callback for numeric and for string keys
+        forEach(
+            [](void *data, int64_t key, const ValueRef &value) { (*static_cast<V*>(data))(key, value); },
+            [](void *data, const StringView &key, const ValueRef &value) { (*static_cast<V*>(data))(key, value); },
+            (void *)&visitor
+        );
+    }
+
+    /**
+     *  Turn the reference into a Php::Value, that does own the variable and
+     *  that can be stored or returned
+     *  @return Value
+     */
+    Value value() const { return Value(_val); }
+
+private:
+    /**
+     *  Visit all elements of the array or object
+     *  @param  numeric     Callback for elements with a numeric key
+     *  @param  string      Callback for elements with a string key
+     *  @param  data        The visitor that is passed to the callbacks
+     */
+    void forEach(void (*numeric)(void *data, int64_t key, const ValueRef &value), void (*string)(void *data, const StringView &key, const ValueRef &value), void *data) const;
+
+    /**
+     *  The variable that is referred to
+     *  @var struct _zval_struct
+     */
+    struct _zval_struct *_val;
+
+    /**
+     *  The value class uses the same implementation to visit arrays
+     */
+    friend class Value;
+};
+
+/**
+ *  End of namespace
+ */
+}
@@ -21,8 +21,14 @@
 #include <list>
 #include <exception>
 #include <map>
+#include <unordered_map>
 #include <set>
 #include <functional>
+#include <tuple>
+#include <type_traits>
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
 
 /**
  *  Include all headers files that are related to this library
@@ -40,10 +46,16 @@
 #include <phpcpp/streams.h>
 #include <phpcpp/message.h>
 #include <phpcpp/type.h>
+#include <phpcpp/stringview.h>
+#include <phpcpp/key.h>
 #include <phpcpp/hashparent.h>
 #include <phpcpp/value.h>
+#include <phpcpp/localvalue.h>
+#include <phpcpp/valueref.h>
+#include <phpcpp/stringbuilder.h>
 #include <phpcpp/valueiterator.h>
 #include <phpcpp/array.h>
+#include <phpcpp/arraybuilder.h>
 #include <phpcpp/object.h>
 #include <phpcpp/globals.h>
 #include <phpcpp/argument.h>
@@ -52,6 +64,7 @@
 #include <phpcpp/global.h>
 #include <phpcpp/hashmember.h>
 #include <phpcpp/super.h>
+#include <phpcpp/smallvector.h>
 #include <phpcpp/parameters.h>
 #include <phpcpp/modifiers.h>
 #include <phpcpp/base.h>
@@ -61,14 +74,19 @@
 #include <phpcpp/traversable.h>
 #include <phpcpp/serializable.h>
 #include <phpcpp/classtype.h>
+#include <phpcpp/poolstatistics.h>
 #include <phpcpp/classbase.h>
 #include <phpcpp/constant.h>
 #include <phpcpp/interface.h>
 #include <phpcpp/zendcallable.h>
+#include <phpcpp/typedfunction.h>
 #include <phpcpp/class.h>
 #include <phpcpp/namespace.h>
 #include <phpcpp/extension.h>
 #include <phpcpp/call.h>
+#include <phpcpp/callsite.h>
+#include <phpcpp/binary.h>
+#include <phpcpp/json.h>
 #include <phpcpp/script.h>
 #include <phpcpp/file.h>
 #include <phpcpp/function.h>
@@ -12,6 +12,118 @@
  */
 namespace Php {
     
+/**
+ *  Helper class to run an arithmetic operation on two integers. It reports
+ *  when the result does not fit in an integer, in which case PHP turns the
+ *  result into a floating point number
+ */
+template < template<typename T> class F>
+struct Overflow
+{
+    /**
+     *  Run the operation
+     *  @param  a
+     *  @param  b
+     *  @param  result
+     *  @return bool        Did the operation overflow?
+     */
+    static bool apply(int64_t a, int64_t b, int64_t *result)
+    {
+        // other operations can not overflow
+        *result = F<int64_t>()(a, b);
+        return false;
+    }
+
+    /**
+     *  Is the operation undefined for a certain right hand operand?
+     *  @param  b
+     *  @return bool
+     */
+    static bool undefined(double b) { return false; }
+};
+
+/**
+ *  Specialization for additions
+ */
+template <>
+struct Overflow<std::plus>
+{
+    static bool apply(int64_t a, int64_t b, int64_t *result)
+    {
+        // check if the result fits
+        if (b > 0 ? a > std::numeric_limits<int64_t>::max() - b : a < std::numeric_limits<int64_t>::min() - b) return true;
+
+        // no overflow
+        *result = a + b;
+        return false;
+    }
+
+    static bool undefined(double b) { return false; }
+};
+
+/**
+ *  Specialization for subtractions
+ */
+template <>
+struct Overflow<std::minus>
+{
+    static bool apply(int64_t a, int64_t b, int64_t *result)
+    {
+        // check if the result fits
+        if (b < 0 ? a > std::numeric_limits<int64_t>::max() + b : a < std::numeric_limits<int64_t>::min() + b) return true;
+
+        // no overflow
+        *result = a - b;
+        return false;
+    }
+
+    static bool undefined(double b) { return false; }
+};
+
+/**
+ *  Specialization for multiplications
+ */
+template <>
+struct Overflow<std::multiplies>
+{
+    static bool apply(int64_t a, int64_t b, int64_t *result)
+    {
+        // the boundaries
+        const int64_t max = std::numeric_limits<int64_t>::max();
+        const int64_t min = std::numeric_limits<int64_t>::min();
+
+        // check if the result fits
+        if (a > 0 ? (b > 0 ? a > max / b : b < min / a) : (b > 0 ? a < min / b : (a != 0 && b < max / a))) return true;
+
+        // no overflow
+        *result = a * b;
+        return false;
+    }
+
+    static bool undefined(double b) { return false; }
+};
+
+/**
+ *  Specialization for divisions, just like in PHP the result is only an
+ *  integer if the division has no remainder, and a division by zero is
+ *  not a number at all
+ */
+template <>
+struct Overflow<std::divides>
+{
+    static bool apply(int64_t a, int64_t b, int64_t *result)
+    {
+        // division by zero, and divisions with a remainder become floats
+        if (b == 0 || (b == -1 && a == std::numeric_limits<int64_t>::min()) || a % b != 0) return true;
+
+        // no overflow
+        *result = a / b;
+        return false;
+    }
+
+    static bool undefined(double b) { return b == 0.0; }
+};
+
 /**
  *  Class definition
  */
@@ -52,10 +164,10 @@ public:
     Value apply(int16_t value)
     {
         // check if the current object is a floating point number
-        if (_value->isFloat()) return Value(F<double>()(_value->floatValue(), value));
+        if (_value->isFloat()) return calculate(_value->floatValue(), (double)value);
         
         // apply to natural numbers
-        return Value(F<int64_t>()(_value->numericValue(), value));
+        return calculate(_value->numericValue(), value);
     }
     
     /**
@@ -66,10 +178,10 @@ public:
     Value apply(int32_t value)
     {
         // check if the current object is a floating point number
-        if (_value->isFloat()) return Value(F<double>()(_value->floatValue(), value));
+        if (_value->isFloat()) return calculate(_value->floatValue(), (double)value);
         
         // apply to natural numbers
-        return Value(F<int64_t>()(_value->numericValue(), value));
+        return calculate(_value->numericValue(), value);
     }
 
     /**
@@ -80,10 +192,10 @@ public:
     Value apply(int64_t value)
     {
         // check if the current object is a floating point number
-        if (_value->isFloat()) return Value(F<double>()(_value->floatValue(), value));
+        if (_value->isFloat()) return calculate(_value->floatValue(), (double)value);
         
         // apply to natural numbers
-        return Value(F<int64_t>()(_value->numericValue(), value));
+        return calculate(_value->numericValue(), value);
     }
         
     /**
@@ -94,10 +206,10 @@ public:
     Value apply(bool value)
     {
         // check if the current object is a floating point number
-        if (_value->isFloat()) return Value(F<double>()(_value->floatValue(), value?1:0));
+        if (_value->isFloat()) return calculate(_value->floatValue(), value ? 1.0 : 0.0);
         
         // apply to natural numbers
-        return Value(F<int64_t>()(_value->numericValue(), value?1:0));
+        return calculate(_value->numericValue(), value?1:0);
     }
     
     /**
@@ -111,10 +223,10 @@ public:
         int v = value < '0' || value > '9' ? 0 : value - '0';
 
         // check if the current object is a floating point number
-        if (_value->isFloat()) return Value(F<double>()(_value->floatValue(), v));
+        if (_value->isFloat()) return calculate(_value->floatValue(), (double)v);
         
         // apply to natural numbers
-        return Value(F<int64_t>()(_value->numericValue(), v));
+        return calculate(_value->numericValue(), v);
     }
     
     /**
@@ -146,7 +258,7 @@ public:
      */
     Value apply(double value)
     {
-        return Value(F<double>()(_value->floatValue(), value));
+        return calculate(_value->floatValue(), value);
     }
     
     /**
@@ -171,10 +283,10 @@ public:
     Value &assign(int16_t value)
     {
         // is the current object a floating point type?
-        if (_value->isFloat()) return _value->operator=(F<double>()(_value->floatValue(), value));
+        if (_value->isFloat()) return store(_value->floatValue(), (double)value);
         
         // do a numeric operation
-        return _value->operator=(F<int64_t>()(_value->numericValue(), value));
+        return store(_value->numericValue(), value);
     }
     
     /**
@@ -185,10 +297,10 @@ public:
     Value &assign(int32_t value)
     {
         // is the current object a floating point type?
-        if (_value->isFloat()) return _value->operator=(F<double>()(_value->floatValue(), value));
+        if (_value->isFloat()) return store(_value->floatValue(), (double)value);
         
         // do a numeric operation
-        return _value->operator=(F<int64_t>()(_value->numericValue(), value));
+        return store(_value->numericValue(), value);
     }
 
     /**
@@ -199,10 +311,10 @@ public:
     Value &assign(int64_t value)
     {
         // is the current object a floating point type?
-        if (_value->isFloat()) return _value->operator=(F<double>()(_value->floatValue(), value));
+        if (_value->isFloat()) return store(_value->floatValue(), (double)value);
         
         // do a numeric operation
-        return _value->operator=(F<int64_t>()(_value->numericValue(), value));
+        return store(_value->numericValue(), value);
     }
 
     /**
@@ -213,10 +325,10 @@ public:
     Value &assign(bool value)
     {
         // is the current object a floating point type?
-        if (_value->isFloat()) return _value->operator=(F<double>()(_value->floatValue(), value?1:0));
+        if (_value->isFloat()) return store(_value->floatValue(), value ? 1.0 : 0.0);
         
         // do a numeric operation
-        return _value->operator=(F<int64_t>()(_value->numericValue(), value?1:0));
+        return store(_value->numericValue(), value?1:0);
     }
     
     /**
@@ -230,10 +342,10 @@ public:
         int v = value < '0' || value > '9' ? 0 : value - '0';
         
         // is the current object a floating point type?
-        if (_value->isFloat()) return _value->operator=(F<double>()(_value->floatValue(), v));
+        if (_value->isFloat()) return store(_value->floatValue(), (double)v);
         
         // do a numeric operation
-        return _value->operator=(F<int64_t>()(_value->numericValue(), v));
+        return store(_value->numericValue(), v);
     }
 
     /**
@@ -266,10 +378,146 @@ public:
     Value &assign(double value)
     {
         // do float operation
-        return _value->operator=(F<double>()(_value->floatValue(), value));
+        return store(_value->floatValue(), value);
     }
     
 private:
+    /**
+     *  Run the operation on two floating point numbers, and return a new
+     *  value object that holds the result (false if the operation is not
+     *  defined for the operands, just like PHP does for a division by zero)
+     *  @param  a
+     *  @param  b
+     *  @return Value
+     */
+    Value calculate(double a, double b)
+    {
+        // some operations are not defined for all operands
+        if (Overflow<F>::undefined(b)) return undefined();
+
+        // run the operation
+        return Value(F<double>()(a, b));
+    }
+
+    /**
+     *  Run the operation on two integers, and return a new value object
+     *  that holds the result (a float if the result does not fit)
+     *  @param  a
+     *  @param  b
+     *  @return Value
+     */
+    Value calculate(int64_t a, int64_t b)
+    {
+        // the result
+        int64_t result;
+
+        // run the operation, on overflow we switch to floating point
+        if (Overflow<F>::apply(a, b, &result)) return calculate((double)a, (double)b);
+
+        // the result fits in an integer
+        return Value(result);
+    }
+
+    /**
+     *  Run the operation on two integers, and store the result in the
+     *  original object (as a float if the result does not fit)
+     *  @param  a
+     *  @param  b
+     *  @return Value
+     */
+    Value &store(int64_t a, int64_t b)
+    {
+        // the result
+        int64_t result;
+
+        // run the operation, on overflow we switch to floating point
+        if (Overflow<F>::apply(a, b, &result)) return store((double)a, (double)b);
+
+        // the result fits in an integer
+        return store(result);
+    }
+
+    /**
+     *  Run the operation on two floating point numbers, and store the result
+     *  in the original object (false if the operation is not defined)
+     *  @param  a
+     *  @param  b
+     *  @return Value
+     */
+    Value &store(double a, double b)
+    {
+        // some operations are not defined for all operands
+        if (Overflow<F>::undefined(b)) return _value->operator=(undefined());
+
+        // run the operation
+        return store(F<double>()(a, b));
+    }
+
+    /**
+     *  Report an operation that is not defined, PHP only does this for a
+     *  division by zero, and its result is false
+     *  @return Value
+     */
+    Value undefined()
+    {
+        // this is what PHP reports
+        Php::warning << "Division by zero" << std::flush;
+
+        // the result is false
+        return Value(false);
+    }
+
+    /**
+     *  Store an integer in the original object
+     *  @param  result
+     *  @return Value
+     */
+    Value &store(int64_t result)
+    {
+        // the zval to update
+        zval *val = _value->_val;
+
+        // if we are the only user of a zval that holds a number, we can
+        // overwrite it right away, there is nothing to destruct or to separate
+        if ((Z_TYPE_P(val) == IS_LONG || Z_TYPE_P(val) == IS_DOUBLE) && (Z_ISREF_P(val) || Z_REFCOUNT_P(val) == 1))
+        {
+            // update the value
+            ZVAL_LONG(val, result);
+
+            // done
+            return *_value;
+        }
+
+        // use the regular assignment
+        return _value->operator=(result);
+    }
+
+    /**
+     *  Store a floating point number in the original object
+     *  @param  result
+     *  @return Value
+     */
+    Value &store(double result)
+    {
+        // the zval to update
+        zval *val = _value->_val;
+
+        // if we are the only user of a zval that holds a number, we can
+        // overwrite it right away, there is nothing to destruct or to separate
+        if ((Z_TYPE_P(val) == IS_LONG || Z_TYPE_P(val) == IS_DOUBLE) && (Z_ISREF_P(val) || Z_REFCOUNT_P(val) == 1))
+        {
+            // update the value
+            ZVAL_DOUBLE(val, result);
+
+            // done
+            return *_value;
+        }
+
+        // use the regular assignment
+        return _value->operator=(result);
+    }
+
+
     /**
      *  Pointer to the original value object
      *  @var    Value
@@ -0,0 +1,172 @@
+/**
+ *  ArrayBuilder.cpp
+ *
+ *  Implementation of the ArrayBuilder class
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2019 Copernica BV
+ */
+#include "includes.h"
+#include "keytable.h"
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Constructor
+ *  @param  size        Expected number of elements
+ */
+ArrayBuilder::ArrayBuilder(size_t size) : _array(nullptr)
+{
+    // turn the value into an array with the right size (this is the only place
+    // where we separate: after this the builder is the only owner of the array)
+    _array.reserveArray(size);
+}
+
+/**
+ *  Append an element to the end of the array
+ *  @param  value
+ *  @return ArrayBuilder
+ */
+ArrayBuilder &ArrayBuilder::append(std::nullptr_t value)
+{
+    // add the element
+    add_next_index_null(_array._val);
+
+    // allow chaining
+    return *this;
+}
+
+/**
+ *  Append an element to the end of the array
+ *  @param  value
+ *  @return ArrayBuilder
+ */
+ArrayBuilder &ArrayBuilder::append(int64_t value)
+{
+    // add the element
+    add_next_index_long(_array._val, value);
+
+    // allow chaining
+    return *this;
+}
+
+/**
+ *  Append an element to the end of the array
+ *  @param  value
+ *  @return ArrayBuilder
+ */
+ArrayBuilder &ArrayBuilder::append(bool value)
+{
+    // add the element
+    add_next_index_bool(_array._val, value);
+
+    // allow chaining
+    return *this;
+}
+
+/**
+ *  Append an element to the end of the array
+ *  @param  value
+ *  @return ArrayBuilder
+ */
+ArrayBuilder &ArrayBuilder::append(double value)
+{
+    // add the element
+    add_next_index_double(_array._val, value);
+
+    // allow chaining
+    return *this;
+}
+
+/**
+ *  Append an element to the end of the array
+ *  @param  value
+ *  @return ArrayBuilder
+ */
+ArrayBuilder &ArrayBuilder::append(const StringView &value)
+{
+    // add the element (cast is necessary for php 5.3)
+    add_next_index_stringl(_array._val, const_cast<char *>(value.data() ? value.data() : ""), value.size(), 1);
+
+    // allow chaining
+    return *this;
+}
+
+/**
+ *  Append an element to the end of the array
+ *  @param  value
+ *  @return ArrayBuilder
+ */
+ArrayBuilder &ArrayBuilder::append(const Value &value)
+{
+    // add the element
+    add_next_index_zval(_array._val, value._val);
+
+    // the variable has one more reference (the array entry)
+    Z_ADDREF_P(value._val);
+
+    // allow chaining
+    return *this;
+}
+
+/**
+ *  Set an element with a specific index
+ *  @param  index
+ *  @param  value
+ *  @return ArrayBuilder
+ */
+ArrayBuilder &ArrayBuilder::set(int64_t index, const Value &value)
+{
+    // add the element
+    add_index_zval(_array._val, index, value._val);
+
+    // the variable has one more reference (the array entry)
+    Z_ADDREF_P(value._val);
+
+    // allow chaining
+    return *this;
+}
+
+/**
+ *  Set an element with a specific key
+ *  @param  key
+ *  @param  value
+ *  @return ArrayBuilder
+ */
+ArrayBuilder &ArrayBuilder::set(const std::string &key, const Value &value)
+{
+    // add the element
+    add_assoc_zval_ex(_array._val, key.c_str(), key.size() + 1, value._val);
+
+    // the variable has one more reference (the array entry)
+    Z_ADDREF_P(value._val);
+
+    // allow chaining
+    return *this;
+}
+
+/**
+ *  Set an element with a precomputed key
+ *  @param  key
+ *  @param  value
+ *  @return ArrayBuilder
+ */
+ArrayBuilder &ArrayBuilder::set(const Key &key, const Value &value)
+{
+    // add the element, without hashing the key again
+    update(Z_ARRVAL_P(_array._val), key, value._val);
+
+    // the variable has one more reference (the array entry)
+    Z_ADDREF_P(value._val);
+
+    // allow chaining
+    return *this;
+}
+
+/**
+ *  End of namespace
+ */
+}
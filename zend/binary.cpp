@@ -0,0 +1,50 @@
+/**
+ *  Binary.cpp
+ *
+ *  Implementation of the binary_serialize() and binary_unserialize() functions
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2019 Copernica BV
+ */
+#include "includes.h"
+#include "binaryencoder.h"
+#include "binarydecoder.h"
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Serialize a value into a binary string
+ *  @param  value       The value to serialize
+ *  @return Value       The binary string
+ */
+Value binary_serialize(const Value &value)
+{
+    // encode the value
+    BinaryEncoder encoder(value);
+
+    // expose the output
+    return encoder.output();
+}
+
+/**
+ *  Turn a binary string back into a value
+ *  @param  buffer      The binary string
+ *  @param  size        Size of the binary string
+ *  @return Value
+ */
+Value binary_unserialize(const char *buffer, size_t size)
+{
+    // decode the input
+    BinaryDecoder decoder(buffer, size);
+
+    // expose the result
+    return std::move(decoder.result());
+}
+
+/**
+ *  End of namespace
+ */
+}
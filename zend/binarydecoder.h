@@ -0,0 +1,298 @@
+/**
+ *  BinaryDecoder.h
+ *
+ *  Class that reads a value in the binary format (see BinaryFormat.h)
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2019 Copernica BV
+ */
+
+/**
+ *  Include guard
+ */
+#pragma once
+
+/**
+ *  Dependencies
+ */
+#include "binaryformat.h"
+
+/**
+ *  Begin of namespace
+ */
+namespace Php {
+
+/**
+ *  Class definition
+ */
+class BinaryDecoder
+{
+private:
+    /**
+     *  The current position in the input
+     *  @var const char *
+     */
+    const char *_pos;
+
+    /**
+     *  The end of the input
+     *  @var const char *
+     */
+    const char *_end;
+
+    /**
+     *  The strings that were read so far (these point into the input)
+     *  @var std::vector
+     */
+    std::vector<StringView> _strings;
+
+    /**
+     *  Buffer to build null terminated keys
+     *  @var std::string
+     */
+    std::string _key;
+
+    /**
+     *  The result
+     *  @var Value
+     */
+    Value _result;
+
+    /**
+     *  Helper function to report invalid input
+     */
+    static void invalid()
+    {
+        throw Exception("Invalid input for binary_unserialize()");
+    }
+
+    /**
+     *  Read a tag
+     *  @return uint8_t
+     */
+    uint8_t tag()
+    {
+        // there should be input left
+        if (_pos >= _end) invalid();
+
+        // read the byte
+        return (uint8_t)*_pos++;
+    }
+
+    /**
+     *  Read a variable length number
+     *  @return uint64_t
+     */
+    uint64_t number()
+    {
+        // the result
+        uint64_t result = 0;
+
+        // read seven bits at a time
+        for (int shift = 0; shift < 64; shift += 7)
+        {
+            // read the next byte
+            uint8_t byte = tag();
+
+            // add the bits
+            result |= (uint64_t)(byte & 0x7f) << shift;
+
+            // are we done?
+            if ((byte & 0x80) == 0) return result;
+        }
+
+        // the number is too long
+        invalid();
+        return 0;
+    }
+
+    /**
+     *  Read an integer (the tag was already read)
+     *  @return int64_t
+     */
+    int64_t integer()
+    {
+        // undo the zigzag encoding
+        uint64_t value = number();
+        return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+    }
+
+    /**
+     *  Read a string (the tag was already read)
+     *  @return StringView
+     */
+    StringView string()
+    {
+        // the size of the string
+        uint64_t size = number();
+
+        // there must be enough input
+        if (size > (uint64_t)(_end - _pos)) invalid();
+
+        // the string
+        StringView result(_pos, size);
+        _pos += size;
+
+        // remember the string, later references may refer to it
+        _strings.push_back(result);
+
+        // done
+        return result;
+    }
+
+    /**
+     *  Read a reference to a string (the tag was already read)
+     *  @return StringView
+     */
+    StringView reference()
+    {
+        // the index of the string
+        uint64_t index = number();
+
+        // it must refer to a string that was already read
+        if (index >= _strings.size()) invalid();
+
+        // done
+        return _strings[index];
+    }
+
+    /**
+     *  Read a value
+     *  @param  depth       Depth of nested arrays
+     *  @return Value
+     */
+    Value read(int depth)
+    {
+        // the tag tells us the type
+        switch (tag()) {
+        case BinaryFormat::Null:        return nullptr;
+        case BinaryFormat::False:       return false;
+        case BinaryFormat::True:        return true;
+        case BinaryFormat::Integer:     return integer();
+        case BinaryFormat::Float:       return floating();
+        case BinaryFormat::String:      { auto data = string(); return Value(data.data(), data.size()); }
+        case BinaryFormat::Reference:   { auto data = reference(); return Value(data.data(), data.size()); }
+        case BinaryFormat::Array:       return array(depth);
+        default:                        invalid(); return nullptr;
+        }
+    }
+
+    /**
+     *  Read a floating point number (the tag was already read)
+     *  @return double
+     */
+    double floating()
+    {
+        // there must be enough input
+        if (_end - _pos < (ptrdiff_t)sizeof(double)) invalid();
+
+        // copy the bytes
+        double result;
+        memcpy(&result, _pos, sizeof(double));
+        _pos += sizeof(double);
+
+        // done
+        return result;
+    }
+
+    /**
+     *  Read an array (the tag was already read)
+     *  @param  depth       Depth of nested arrays
+     *  @return Value
+     */
+    Value array(int depth)
+    {
+        // prevent endless recursion
+        if (depth >= BinaryFormat::depth) invalid();
+
+        // the number of elements
+        uint64_t count = number();
+
+        // every element takes at least two bytes, a bigger number can not be valid
+        // (this also prevents that we allocate a huge table for a corrupt input)
+        if (count > (uint64_t)(_end - _pos) / 2) invalid();
+
+        // create the array at its final size
+        Value result(Type::Array);
+        result.reserveArray(count);
+
+        // the hash table to fill
+        HashTable *table = Z_ARRVAL_P(result._val);
+
+        // read all elements
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            // the type of key
+            uint8_t type = tag();
+
+            // numeric key
+            if (type == BinaryFormat::Integer)
+            {
+                // read the key and the value
+                long index = integer();
+                Value value = read(depth + 1);
+
+                // add it to the table, which now also holds a reference
+                zend_hash_index_update(table, index, (void *)&value._val, sizeof(zval *), nullptr);
+                Z_ADDREF_P(value._val);
+            }
+            else
+            {
+                // read the key
+                StringView key;
+                if (type == BinaryFormat::String) key = string();
+                else if (type == BinaryFormat::Reference) key = reference();
+                else invalid();
+
+                // read the value (the key points into the input, so it stays valid)
+                Value value = read(depth + 1);
+
+                // zend needs a null terminated key, the buffer for it is shared
+                // by all levels, so it can only be filled after the nested value
+                // has been read
+                _key.assign(key.data(), key.size());
+
+                // add it to the table (numeric strings are turned into numeric keys)
+                zend_symtable_update(table, _key.c_str(), _key.size() + 1, (void *)&value._val, sizeof(zval *), nullptr);
+                Z_ADDREF_P(value._val);
+            }
+        }
+
+        // done
+        return result;
+    }
+
+public:
+    /**
+     *  Constructor
+     *  @param  buffer      The input
+     *  @param  size        Size of the input
+     */
+    BinaryDecoder(const char *buffer, size_t size) : _pos(buffer), _end(buffer + size)
+    {
+        // check the version
+        if (tag() != BinaryFormat::version) invalid();
+
+        // read the value
+        _result = read(0);
+
+        // all input should be used
+        if (_pos != _end) invalid();
+    }
+
+    /**
+     *  Destructor
+     */
+    virtual ~BinaryDecoder() = default;
+
+    /**
+     *  Retrieve the result
+     *  @return Value
+     */
+    Value &result() { return _result; }
+};
+
+/**
+ *  End of namespace
+ */
+}
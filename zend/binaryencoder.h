@@ -0,0 +1,209 @@
+/**
+ *  BinaryEncoder.h
+ *
+ *  Class that writes a value in the binary format (see BinaryFormat.h)
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2019 Copernica BV
+ */
+
+/**
+ *  Include guard
+ */
+#pragma once
+
+/**
+ *  Dependencies
+ */
+#include "binaryformat.h"
+
+/**
+ *  Begin of namespace
+ */
+namespace Php {
+
+/**
+ *  Class definition
+ */
+class BinaryEncoder
+{
+private:
+    /**
+     *  Hash function for the strings that were already written
+     */
+    struct Hash
+    {
+        size_t operator()(const StringView &string) const { return zend_inline_hash_func(string.data(), string.size()); }
+    };
+
+    /**
+     *  The output buffer
+     *  @var StringBuilder
+     */
+    StringBuilder _output;
+
+    /**
+     *  The strings that were already written, and their index
+     *  @var std::unordered_map
+     */
+    std::unordered_map<StringView,size_t,Hash> _strings;
+
+    /**
+     *  Write a tag
+     *  @param  tag
+     */
+    void tag(BinaryFormat::Tag tag)
+    {
+        _output.append((char)tag);
+    }
+
+    /**
+     *  Write a variable length number
+     *  @param  value
+     */
+    void number(uint64_t value)
+    {
+        // a 64 bit number takes at most ten bytes
+        char *buffer = _output.reserve(10);
+
+        // number of bytes written
+        size_t size = 0;
+
+        // write seven bits at a time, the high bit tells if more bytes follow
+        while (value >= 0x80)
+        {
+            buffer[size++] = (char)(value | 0x80);
+            value >>= 7;
+        }
+
+        // the last byte
+        buffer[size++] = (char)value;
+
+        // done
+        _output.advance(size);
+    }
+
+    /**
+     *  Write a string, or a reference to an earlier string with the same content
+     *  @param  data
+     *  @param  size
+     */
+    void string(const char *data, size_t size)
+    {
+        // the view on the string (the string stays alive while we are encoding)
+        StringView view(data, size);
+
+        // remember the string, unless it was already written
+        auto result = _strings.emplace(view, _strings.size());
+
+        // is this a string that was written before?
+        if (!result.second)
+        {
+            // write a reference
+            tag(BinaryFormat::Reference);
+            number(result.first->second);
+        }
+        else
+        {
+            // write the string itself
+            tag(BinaryFormat::String);
+            number(size);
+            _output.append(data, size);
+        }
+    }
+
+    /**
+     *  Write a value
+     *  @param  value
+     *  @param  depth       Depth of nested arrays
+     */
+    void write(zval *value, int depth)
+    {
+        // check the type
+        switch (Z_TYPE_P(value)) {
+        case IS_NULL:       return tag(BinaryFormat::Null);
+        case IS_BOOL:       return tag(Z_BVAL_P(value) ? BinaryFormat::True : BinaryFormat::False);
+        case IS_LONG:       return integer(Z_LVAL_P(value));
+        case IS_DOUBLE:     return floating(Z_DVAL_P(value));
+        case IS_STRING:     return string(Z_STRVAL_P(value), Z_STRLEN_P(value));
+        case IS_ARRAY:      return array(Z_ARRVAL_P(value), depth);
+        default:            throw Exception("Only null, booleans, numbers, strings and arrays can be serialized");
+        }
+    }
+
+    /**
+     *  Write an integer
+     *  @param  value
+     */
+    void integer(int64_t value)
+    {
+        // zigzag encoding makes small negative numbers small too
+        tag(BinaryFormat::Integer);
+        number(((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+    }
+
+    /**
+     *  Write a floating point number
+     *  @param  value
+     */
+    void floating(double value)
+    {
+        // write the bytes of the number
+        tag(BinaryFormat::Float);
+        _output.append((const char *)&value, sizeof(double));
+    }
+
+    /**
+     *  Write an array
+     *  @param  table
+     *  @param  depth       Depth of nested arrays
+     */
+    void array(HashTable *table, int depth)
+    {
+        // prevent endless recursion
+        if (depth >= BinaryFormat::depth) throw Exception("Arrays are nested too deep to be serialized");
+
+        // write the number of elements
+        tag(BinaryFormat::Array);
+        number(zend_hash_num_elements(table));
+
+        // write all elements
+        for (Bucket *bucket = table->pListHead; bucket; bucket = bucket->pListNext)
+        {
+            // write the key
+            if (bucket->nKeyLength == 0) integer((long)bucket->h);
+            else string(bucket->arKey, bucket->nKeyLength - 1);
+
+            // write the value
+            write(*(zval **)bucket->pData, depth + 1);
+        }
+    }
+
+public:
+    /**
+     *  Constructor
+     *  @param  value       The value to encode
+     */
+    BinaryEncoder(const Value &value)
+    {
+        // write the version, and the value
+        _output.append((char)BinaryFormat::version);
+        write(value._val, 0);
+    }
+
+    /**
+     *  Destructor
+     */
+    virtual ~BinaryEncoder() = default;
+
+    /**
+     *  Retrieve the output
+     *  @return Value
+     */
+    Value output() { return _output.value(); }
+};
+
+/**
+ *  End of namespace
+ */
+}
@@ -0,0 +1,68 @@
+/**
+ *  BinaryFormat.h
+ *
+ *  Constants that describe the binary format that is written by the
+ *  BinaryEncoder and read by the BinaryDecoder.
+ *
+ *  The output starts with a version byte, followed by the value. Every value
+ *  starts with a tag byte:
+ *
+ *      null, false, true       only the tag
+ *      integer                 zigzag encoded variable length number
+ *      float                   eight bytes, native byte order
+ *      string                  variable length size, followed by the bytes
+ *      string reference        variable length index of an earlier string
+ *      array                   variable length number of elements, followed
+ *                              by the key (an integer, string or string
+ *                              reference) and the value of each element
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2019 Copernica BV
+ */
+
+/**
+ *  Include guard
+ */
+#pragma once
+
+/**
+ *  Begin of namespace
+ */
+namespace Php {
+
+/**
+ *  Class definition
+ */
+class BinaryFormat
+{
+public:
+    /**
+     *  Version of the format
+     */
+    static const uint8_t version = 1;
+
+    /**
+     *  Maximum depth of nested arrays
+     */
+    static const int depth = 256;
+
+    /**
+     *  The tags
+     */
+    enum Tag : uint8_t
+    {
+        Null        = 0,
+        False       = 1,
+        True        = 2,
+        Integer     = 3,
+        Float       = 4,
+        String      = 5,
+        Reference   = 6,
+        Array       = 7
+    };
+};
+
+/**
+ *  End of namespace
+ */
+}
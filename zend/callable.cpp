@@ -25,18 +25,19 @@ namespace Php {
  */
 void Callable::invoke(INTERNAL_FUNCTION_PARAMETERS)
 {
-    // find the function name
-    const char *name = get_active_function_name(TSRMLS_C);
+    // the function that is being called
+    zend_function *function = EG(current_execute_data)->function_state.function;
 
-    // uncover the hidden pointer inside the function name
-    Callable *callable = HiddenPointer<Callable>(name);
+    // the object is stored in the record in front of the function info, which
+    // is in front of the argument info that the function points to
+    Callable *callable = (Callable *)(function->common.arg_info - 2)->name;
 
     // check if sufficient parameters were passed (for some reason this check
     // is not done by Zend, so we do it here ourselves)
     if (ZEND_NUM_ARGS() < callable->_required)
     {
         // PHP itself only generates a warning when this happens, so we do the same too
-        Php::warning << name << "() expects at least " << callable->_required << " parameters, " << ZEND_NUM_ARGS() << " given" << std::flush;
+        Php::warning << callable->_name << "() expects at least " << callable->_required << " parameters, " << ZEND_NUM_ARGS() << " given" << std::flush;
 
         // and we return null
         RETURN_NULL();
@@ -50,15 +51,13 @@ void Callable::invoke(INTERNAL_FUNCTION_PARAMETERS)
         try
         {
             // get the result
-            Value result(callable->invoke(params));
+            Value result(callable->_invoker(callable, params));
 
             // we're ready if the return value is not even used
             if (!return_value_used) return;
 
-            // @todo php 5.6 has a RETVAL_ZVAL_FAST macro that can be used instead (and is faster)
-
-            // return a full copy of the zval, and do not destruct it
-            RETVAL_ZVAL(result._val, 1, 0);
+            // move the result into the return value (this avoids copying strings and arrays)
+            result.moveTo(return_value, return_value_ptr);
         }
         catch (Throwable &exception)
         {
@@ -85,9 +84,13 @@ void Callable::initialize(zend_function_entry *entry, const char *classname, int
     if (_callback)  entry->handler = (void(*)(INTERNAL_FUNCTION_PARAMETERS))_callback;
     else            entry->handler = &Callable::invoke;
 
-    // fill the members of the entity, and hide a pointer to the current object in the name
-    entry->fname = (const char *)_ptr;
-    entry->arg_info = _argv.get();
+    // store a pointer to the current object in the first record, in front
+    // of the records that are passed to the engine
+    _argv[0].name = (const char *)this;
+
+    // fill the members of the entity
+    entry->fname = _name.c_str();
+    entry->arg_info = &_argv[1];
     entry->num_args = _argc;
     entry->flags = flags;
 
@@ -109,9 +112,9 @@ void Callable::initialize(zend_arg_info *info, const char *classname) const
 
     // fill in all the members, note that return reference is false by default,
     // because we do not support returning references in PHP-CPP, although Zend
-    // engine allows it. Inside the name we hide a pointer to the current object
-    finfo->_name = _ptr;
-    finfo->_name_len = ::strlen(_ptr);
+    // engine allows it.
+    finfo->_name = _name.c_str();
+    finfo->_name_len = _name.size();
     finfo->_class_name = classname;
 
     // number of required arguments, and the expected return type
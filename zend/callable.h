@@ -19,6 +19,13 @@ namespace Php {
 class Callable
 {
 public:
+    /**
+     *  Function that runs the actual C++ callback. Derived classes set this
+     *  to a function that knows the signature of their callback, so that no
+     *  switch is needed when the function is called.
+     */
+    using Invoker = Value (*)(Callable *callable, Parameters &params);
+
     /**
      *  Constructor
      *
@@ -28,13 +35,14 @@ public:
      */
     Callable(ZendCallback callback, const char *name, const Arguments &arguments = {}) :
         _callback(callback),
-        _ptr(this, name),
+        _name(name),
         _argc(arguments.size()),
-        _argv(new zend_arg_info[_argc + 1])
+        _argv(new zend_arg_info[_argc + 2])
     {
-        // the first record is initialized with information about the function,
-        // so we skip that here
-        int i=1;
+        // the first record holds the pointer to this object, and the second
+        // record is initialized with information about the function, so we
+        // skip these here
+        int i=2;
         
         // loop through the arguments
         for (auto it = arguments.begin(); it != arguments.end(); it++)
@@ -61,7 +69,8 @@ public:
      *  @param  that
      */
     Callable(const Callable &that) :
-        _ptr(that._ptr),
+        _invoker(that._invoker),
+        _name(that._name),
         _return(that._return),
         _required(that._required),
         _argc(that._argc),
@@ -72,7 +81,8 @@ public:
      *  @param  that
      */
     Callable(Callable &&that) :
-        _ptr(std::move(that._ptr)),
+        _invoker(that._invoker),
+        _name(std::move(that._name)),
         _return(that._return),
         _required(that._required),
         _argc(that._argc),
@@ -83,13 +93,6 @@ public:
      */
     virtual ~Callable() = default;
     
-    /**
-     *  Method that gets called every time the function is executed
-     *  @param  params      The parameters that were passed
-     *  @return Variable    Return value
-     */
-    virtual Value invoke(Parameters &params) = 0;
-    
     /**
      *  Fill a function entry
      *  @param  entry       Entry to be filled
@@ -117,10 +120,16 @@ protected:
     ZendCallback _callback;
 
     /**
-     *  Hidden pointer to the name and the function
-     *  @var    HiddenPointer
+     *  The function that runs the C++ callback
+     *  @var    Invoker
      */
-    HiddenPointer<Callable> _ptr;
+    Invoker _invoker = nullptr;
+
+    /**
+     *  Function or method name
+     *  @var    std::string
+     */
+    std::string _name;
 
     /**
      *  Suggestion for the return type
@@ -142,6 +151,13 @@ protected:
 
     /**
      *  The arguments
+     *
+     *  The first record does not describe an argument, but holds a pointer to
+     *  this object. The Zend engine stores a pointer to the third record (the
+     *  first real argument) in the function, so when the function is called,
+     *  the object is found right in front of the argument info, without
+     *  having to look at the function name.
+     *
      *  @var std::unique_ptr<zend_arg_info[]>
      */
     std::unique_ptr<zend_arg_info[]> _argv;
@@ -0,0 +1,121 @@
+/**
+ *  CallData.cpp
+ *
+ *  Implementation of the list of reusable CallData structures
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2019 Copernica BV
+ */
+#include "includes.h"
+#include "calldata.h"
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  The structures that can be reused (in thread safe mode every thread has
+ *  its own list, because the structures are allocated with emalloc())
+ */
+#ifdef ZTS
+static thread_local CallData *reusable = nullptr;
+#else
+static CallData *reusable = nullptr;
+#endif
+
+/**
+ *  Set the name of the method, the buffer is reused if it is big enough
+ *  @param  name
+ *  @param  size
+ */
+void CallData::setName(const char *name, size_t size)
+{
+    // allocate a bigger buffer if the name does not fit
+    if (size >= capacity)
+    {
+        buffer = (char *)erealloc(buffer, size + 1);
+        capacity = size + 1;
+    }
+
+    // copy the name
+    memcpy(buffer, name, size);
+    buffer[size] = '\0';
+
+    // use it for the function
+    func.function_name = buffer;
+}
+
+/**
+ *  Remove the name of the method, and free the buffer
+ */
+void CallData::clearName()
+{
+    // free the buffer
+    if (buffer) efree(buffer);
+    buffer = nullptr;
+    capacity = 0;
+
+    // the function has no name
+    func.function_name = nullptr;
+}
+
+/**
+ *  Get a structure, from the list of reusable structures if possible
+ *  @return CallData
+ */
+CallData *CallData::allocate()
+{
+    // is there a structure that we can reuse?
+    if (!reusable)
+    {
+        // allocate a new structure, it has no buffer for the name yet
+        CallData *result = (CallData *)emalloc(sizeof(CallData));
+        result->buffer = nullptr;
+        result->capacity = 0;
+
+        // done
+        return result;
+    }
+
+    // take it from the list
+    CallData *result = reusable;
+    reusable = result->next;
+
+    // done
+    return result;
+}
+
+/**
+ *  Give back a structure after the call, so that it can be reused
+ *  @param  data
+ */
+void CallData::release(CallData *data)
+{
+    // add it to the front of the list
+    data->next = reusable;
+    reusable = data;
+}
+
+/**
+ *  Free all reusable structures
+ */
+void CallData::clear()
+{
+    // free all structures
+    while (reusable)
+    {
+        // take the first structure from the list
+        CallData *data = reusable;
+        reusable = data->next;
+
+        // the memory is request memory, so it must be freed before the request ends
+        if (data->buffer) efree(data->buffer);
+        efree(data);
+    }
+}
+
+/**
+ *  End of namespace
+ */
+}
@@ -0,0 +1,119 @@
+/**
+ *  CallData.h
+ *
+ *  Extended zend_internal_function structure that we use for calls to
+ *  __call(), __callStatic() and __invoke(). The Zend engine asks for such
+ *  a structure right before every call to a method that does not exist,
+ *  and the handler that runs the call is responsible for freeing it.
+ *
+ *  Instead of allocating and freeing a structure for every call, the
+ *  structures are kept in a list after the call, so that the next call
+ *  can use them again. The same goes for the buffer that holds the name
+ *  of the method. The list holds request memory, so it is cleared when
+ *  the request ends.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2019 Copernica BV
+ */
+
+/**
+ *  Include guard
+ */
+#pragma once
+
+/**
+ *  Begin of namespace
+ */
+namespace Php {
+
+/**
+ *  Forward declarations
+ */
+class ClassImpl;
+
+/**
+ *  Structure definition
+ */
+struct CallData
+{
+    // the internal function is the first member, so
+    // that it is possible to cast an instance of this
+    // struct to a zend_internal_function
+    zend_internal_function func;
+
+    // and a pointer to the ClassImpl object
+    ClassImpl *self;
+
+    // the next structure in the list of reusable structures
+    CallData *next;
+
+    // buffer for the name of the method (this is a separate allocation,
+    // because zend frees the name when the call does not happen, for
+    // example in is_callable()), and the number of bytes that fit in it
+    char *buffer;
+    size_t capacity;
+
+    /**
+     *  Set the name of the method, the buffer is reused if it is big enough
+     *  @param  name
+     *  @param  size
+     */
+    void setName(const char *name, size_t size);
+
+    /**
+     *  Remove the name of the method, and free the buffer
+     */
+    void clearName();
+
+    /**
+     *  Get a structure, from the list of reusable structures if possible
+     *  @return CallData
+     */
+    static CallData *allocate();
+
+    /**
+     *  Give back a structure after the call, so that it can be reused
+     *  @param  data
+     */
+    static void release(CallData *data);
+
+    /**
+     *  Free all reusable structures (called when the request ends)
+     */
+    static void clear();
+};
+
+/**
+ *  Class that gives back a structure when it falls out of scope (like the
+ *  DelayedFree class, but the structure is reused instead of freed)
+ */
+class DelayedRelease
+{
+private:
+    /**
+     *  The structure to give back
+     *  @var CallData
+     */
+    CallData *_data;
+
+public:
+    /**
+     *  Constructor
+     *  @param  data        Structure that will be given back on destruction
+     */
+    DelayedRelease(CallData *data) : _data(data) {}
+
+    /**
+     *  Destructor
+     */
+    ~DelayedRelease()
+    {
+        // give back the structure
+        CallData::release(_data);
+    }
+};
+
+/**
+ *  End of namespace
+ */
+}
@@ -0,0 +1,176 @@
+/**
+ *  CallSite.cpp
+ *
+ *  Implementation of the CallSite class
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2019 Copernica BV
+ */
+#include "includes.h"
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Structure holding the zend call info and the resolved function
+ */
+struct CallSite::Data
+{
+    /**
+     *  The call info
+     *  @var zend_fcall_info
+     */
+    zend_fcall_info info;
+
+    /**
+     *  The resolved function
+     *  @var zend_fcall_info_cache
+     */
+    zend_fcall_info_cache cache;
+
+    /**
+     *  Can the resolved function be reused? This is not the case for
+     *  methods that are handled by __call(), because zend creates a new
+     *  temporary function for those on every call
+     *  @var bool
+     */
+    bool reusable;
+};
+
+/**
+ *  Constructor for anything that is callable
+ *  @param  callable    The function to call
+ */
+CallSite::CallSite(const Value &callable) : _callable(callable), _data(new Data())
+{
+    // resolve the function
+    resolve();
+}
+
+/**
+ *  Constructor for a method of an object
+ *  @param  object      The object
+ *  @param  method      Name of the method
+ */
+CallSite::CallSite(const Value &object, const char *method) : _callable(Type::Array), _data(new Data())
+{
+    // zend accepts an array with the object and the method name as callable
+    _callable.set(0, object);
+    _callable.set(1, method);
+
+    // resolve the function
+    resolve();
+}
+
+/**
+ *  Destructor
+ */
+CallSite::~CallSite()
+{
+    // deallocate the call info
+    delete _data;
+}
+
+/**
+ *  Resolve the function
+ */
+void CallSite::resolve()
+{
+    // we need the tsrm_ls variable
+    TSRMLS_FETCH();
+
+    // the error message
+    char *error = nullptr;
+
+    // look up the function, this fills both the call info and the cache
+    if (zend_fcall_info_init(_callable._val, 0, &_data->info, &_data->cache, nullptr, &error TSRMLS_CC) != SUCCESS)
+    {
+        // we do not need the error message
+        if (error) efree(error);
+
+        // deallocate the call info, the destructor is not going to run
+        delete _data;
+        _data = nullptr;
+
+        // the value is not callable
+        throw Exception("Invalid call to " + _callable.stringValue());
+    }
+
+    // the error message (for example about a deprecated call) is not used
+    if (error) efree(error);
+
+    // methods that are handled by __call() get a temporary function, that we
+    // should free ourselves, and that can not be reused for later calls
+    _data->reusable = (_data->cache.function_handler->common.fn_flags & ZEND_ACC_CALL_VIA_HANDLER) == 0;
+
+    // is it a temporary function?
+    if (_data->reusable) return;
+
+    // the name of the temporary function (__invoke() handlers have none)
+    auto *name = _data->cache.function_handler->common.function_name;
+
+    // free the temporary function, zend resolves it again on every call
+    if (name) efree((char *)name);
+    efree(_data->cache.function_handler);
+
+    // the cache should no longer be used
+    _data->cache.initialized = 0;
+}
+
+/**
+ *  Call the function with a number of parameters
+ *  @param  argc        Number of parameters
+ *  @param  params      The parameters
+ *  @return Value
+ */
+Value CallSite::exec(int argc, struct _zval_struct ***params)
+{
+    // the return zval
+    zval *retval = nullptr;
+
+    // we need the tsrm_ls variable
+    TSRMLS_FETCH();
+
+    // the current exception
+    zval *oldException = EG(exception);
+
+    // set up the call info for this call
+    _data->info.retval_ptr_ptr = &retval;
+    _data->info.param_count = argc;
+    _data->info.params = params;
+    _data->info.no_separation = 1;
+
+    // temporary functions are resolved by zend itself (and freed after the call)
+    if (!_data->reusable) _data->cache.initialized = 0;
+
+    // call the function, without looking it up
+    if (zend_call_function(&_data->info, &_data->cache TSRMLS_CC) != SUCCESS)
+    {
+        // throw an exception, the function could not be called
+        throw Exception("Invalid call to " + _callable.stringValue());
+    }
+
+    // was an exception thrown inside the function? In that case we throw a C++ new exception
+    // to give the C++ code the chance to catch it
+    if (oldException != EG(exception) && EG(exception)) throw OrigException(EG(exception) TSRMLS_CC);
+
+    // leap out if nothing was returned
+    if (!retval) return nullptr;
+
+    // wrap the retval in a value
+    Php::Value result(retval);
+
+    // destruct the retval (this just decrements the refcounter, which is ok, because
+    // it is already wrapped in a Php::Value so still has 1 reference)
+    zval_ptr_dtor(&retval);
+
+    // done
+    return result;
+}
+
+/**
+ *  End of namespace
+ */
+}
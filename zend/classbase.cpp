@@ -131,6 +131,16 @@ void ClassBase::property(const char *name, const getter_callback_1 &getter, cons
 void ClassBase::property(const char *name, const getter_callback_0 &getter, const setter_callback_1 &setter) { _impl->property(name, getter, setter); }
 void ClassBase::property(const char *name, const getter_callback_1 &getter, const setter_callback_1 &setter) { _impl->property(name, getter, setter); }
 
+/**
+ *  Set property that is bound to a data member
+ *  @param  name        Name of the property
+ *  @param  member      The data member
+ */
+void ClassBase::property(const char *name, const int_member &member)     { _impl->property(name, member); }
+void ClassBase::property(const char *name, const float_member &member)   { _impl->property(name, member); }
+void ClassBase::property(const char *name, const bool_member &member)    { _impl->property(name, member); }
+void ClassBase::property(const char *name, const string_member &member)  { _impl->property(name, member); }
+
 /**
  *  Add an interface
  *  @param  interface       Interface object
@@ -143,6 +153,18 @@ void ClassBase::implements(const ClassBase &interface) { _impl->implements(inter
  */
 void ClassBase::extends(const ClassBase &base) { _impl->extends(base._impl); }
 
+/**
+ *  Reuse the memory of destructed objects for new objects
+ *  @param  limit       Max number of objects to keep, zero to disable
+ */
+void ClassBase::pool(size_t limit) { _impl->pool(limit); }
+
+/**
+ *  Statistics of the memory pool
+ *  @return PoolStatistics
+ */
+const PoolStatistics &ClassBase::statistics() const { return _impl->statistics(); }
+
 /**
  *  End namespace
  */
@@ -7,6 +7,7 @@
  *  @copyright 2014 - 2019 Copernica BV
  */
 #include "includes.h"
+#include "calldata.h"
 
 /**
  *  Set up namespace
@@ -91,21 +92,6 @@ static ClassImpl *self(zend_class_entry *entry)
 #endif
 }
 
-/**
- *  Extended zend_internal_function structure that we use to store an
- *  instance of the ClassBase object. We need this for static method calls
- */
-struct CallData
-{
-    // the internal function is the first member, so
-    // that it is possible to cast an instance of this
-    // struct to a zend_internal_function
-    zend_internal_function func;
-
-    // and a pointer to the ClassImpl object
-    ClassImpl *self;
-};
-
 /**
  *  Handler function that runs the __call function
  *  @param  ...     All normal parameters for function calls
@@ -122,10 +108,10 @@ void ClassImpl::callMethod(INTERNAL_FUNCTION_PARAMETERS)
     const char *name = func->function_name;
     ClassBase *meta = data->self->_base;
 
-    // the data structure was allocated by ourselves in the getMethod or
-    // getStaticMethod functions, we no longer need it when the function falls
-    // out of scope
-    DelayedFree df(data);
+    // the data structure was handed out by ourselves in the getMethod or
+    // getStaticMethod functions, we give it back when the function falls
+    // out of scope, so that the next call can reuse it
+    DelayedRelease release(data);
 
     // the function could throw an exception
     try
@@ -169,10 +155,10 @@ void ClassImpl::callInvoke(INTERNAL_FUNCTION_PARAMETERS)
     // get self reference
     ClassBase *meta = data->self->_base;
 
-    // the data structure was allocated by ourselves in the getMethod or
-    // getStaticMethod functions, we no longer need it when the function falls
-    // out of scope
-    DelayedFree df(data);
+    // the data structure was handed out by ourselves in the getMethod or
+    // getStaticMethod functions, we give it back when the function falls
+    // out of scope, so that the next call can reuse it
+    DelayedRelease release(data);
 
     // the function could throw an exception
     try
@@ -236,13 +222,13 @@ zend_function *ClassImpl::getMethod(zval **object_ptr, char *method_name, int me
     // retrieve the class entry linked to this object
     auto *entry = zend_get_class_entry(*object_ptr TSRMLS_CC);
 
-    // this is peculiar behavior of the zend engine, we first are going to dynamically
-    // allocate memory holding all the properties of the __call method (we initially
-    // had an implementation here that used a static variable, and that worked too,
-    // but we'll follow thread safe implementation of the Zend engine here, although
-    // it is strange to allocate and free memory in one and the same method call (free()
-    // call happens in call_method())
-    auto *data = (CallData *)emalloc(sizeof(CallData));
+    // this is peculiar behavior of the zend engine, we first have to hand out
+    // a structure holding all the properties of the __call method, which is given
+    // back when the call is done (in callMethod()). The structure can not be
+    // static, because the engine itself frees it when the call does not happen
+    // (for example in is_callable()), so we take one from a list of structures
+    // that were used before, which saves an allocation for every call
+    auto *data = CallData::allocate();
     auto *function = &data->func;
 
     // we're going to set all properties
@@ -254,7 +240,10 @@ zend_function *ClassImpl::getMethod(zval **object_ptr, char *method_name, int me
     function->required_num_args = 0;
     function->scope = entry;
     function->fn_flags = ZEND_ACC_CALL_VIA_HANDLER;
-    function->function_name = method_name;
+
+    // the name must be a copy, because zend frees it when the call does not
+    // happen, and the buffer that we got is owned by the caller
+    data->setName(method_name, method_len);
 
     // store pointer to ourselves
     data->self = self(entry);
@@ -285,9 +274,9 @@ zend_function *ClassImpl::getStaticMethod(zend_class_entry *entry, char* method,
     // did the default implementation do anything?
     if (defaultFunction) return defaultFunction;
 
-    // just like we did in getMethod() (see comment there) we are going to dynamically
-    // allocate data holding information about the function
-    auto *data = (CallData *)emalloc(sizeof(CallData));
+    // just like we did in getMethod() (see comment there) we are going to hand out
+    // a (reused) structure holding information about the function
+    auto *data = CallData::allocate();
     auto *function = &data->func;
 
     // we're going to set all properties
@@ -299,7 +288,9 @@ zend_function *ClassImpl::getStaticMethod(zend_class_entry *entry, char* method,
     function->required_num_args = 0;
     function->scope = nullptr;
     function->fn_flags = ZEND_ACC_CALL_VIA_HANDLER;
-    function->function_name = method;
+
+    // the name must be a copy (see getMethod())
+    data->setName(method, method_len);
 
     // store pointer to ourselves
     data->self = self(entry);
@@ -330,9 +321,9 @@ int ClassImpl::getClosure(zval *object, zend_class_entry **entry_ptr, zend_funct
     // retrieve the class entry linked to this object
     auto *entry = zend_get_class_entry(object TSRMLS_CC);
 
-    // just like we did for getMethod(), we're going to dynamically allocate memory
-    // with all information about the function
-    auto *data = (CallData *)emalloc(sizeof(CallData));
+    // just like we did for getMethod(), we're going to hand out a (reused)
+    // structure with all information about the function
+    auto *data = CallData::allocate();
     auto *function = &data->func;
 
     // we're going to set all properties
@@ -344,7 +335,10 @@ int ClassImpl::getClosure(zval *object, zend_class_entry **entry_ptr, zend_funct
     function->required_num_args = 0;
     function->scope = entry;
     function->fn_flags = ZEND_ACC_CALL_VIA_HANDLER;
-    function->function_name = nullptr;
+
+    // the function has no name, zend only frees the structure itself when
+    // the call does not happen, so it should not hold a buffer either
+    data->clearName();
 
     // store pointer to ourselves
     data->self = self(entry);
@@ -554,15 +548,18 @@ zend_object_value ClassImpl::cloneObject(zval *val TSRMLS_DC)
     // retrieve the old object, which we are going to copy
     ObjectImpl *old_object = ObjectImpl::find(val TSRMLS_CC);
 
-    // create a new base c++ object
-    auto *cpp = meta->clone(old_object->object());
+    // create the new object, with a copy of the c++ object
+    ObjectImpl *new_object = ObjectImpl::clone(entry, meta, impl->_pool, old_object->object() TSRMLS_CC);
 
     // report error on failure (this does not occur because the cloneObject()
     // method is only installed as handler when we have seen that there is indeed
     // a copy constructor). Because this function is directly called from the
     // Zend engine, we can call zend_error() (which does a longjmp()) to throw
     // an exception back to the Zend engine)
-    if (!cpp) zend_error(E_ERROR, "Unable to clone %s", entry->name);
+    if (!new_object) zend_error(E_ERROR, "Unable to clone %s", entry->name);
+
+    // the new c++ object
+    auto *cpp = new_object->object();
 
     // the thing we're going to return
     zend_object_value result;
@@ -570,9 +567,6 @@ zend_object_value ClassImpl::cloneObject(zval *val TSRMLS_DC)
     // set the handlers
     result.handlers = impl->objectHandlers();
 
-    // store the object
-    ObjectImpl *new_object = new ObjectImpl(entry, cpp, 1 TSRMLS_CC);
-
     // store the object in the object cache
     result.handle = new_object->handle();
 
@@ -905,23 +899,18 @@ zval *ClassImpl::readProperty(zval *object, zval *name, int type, const zend_lit
         // initialized, which makes it impossible to call Value{name} to convert name to a Php::Value
         if (Z_TYPE_P(name) == IS_STRING)
         {
-            // we need a std::string for the lookup in the std::map
-            std::string key(Z_STRVAL_P(name), Z_STRLEN_P(name));
+            // is it a property with a callback? (the engine may have calculated the hash already)
+#if PHP_VERSION_ID < 50399
+            Property *property = impl->_properties.find(Z_STRVAL_P(name), Z_STRLEN_P(name));
+#else
+            Property *property = impl->_properties.find(name, key);
+#endif
 
-            // is it a property with a callback?
-            auto iter = impl->_properties.find(key);
-    
-            // was it found?
-            if (iter == impl->_properties.end())
-            {
-                // retrieve value from the __get method
-                return toZval(meta->callGet(base, key), type);
-            }
-            else
-            {
-                // get the value
-                return toZval(iter->second->get(base), type);
-            }
+            // read the data member directly, or get the value from the getter
+            if (property) return property->member() ? property->read(base) : toZval(property->get(base), type);
+
+            // retrieve value from the __get method
+            return toZval(meta->callGet(base, Value(Z_STRVAL_P(name), Z_STRLEN_P(name))), type);
         }
         else
         {
@@ -929,19 +918,13 @@ zval *ClassImpl::readProperty(zval *object, zval *name, int type, const zend_lit
             Value key(name);
     
             // is it a property with a callback?
-            auto iter = impl->_properties.find(key);
+            Property *property = impl->_properties.find(key);
     
-            // was it found?
-            if (iter == impl->_properties.end())
-            {
-                // retrieve value from the __get method
-                return toZval(meta->callGet(base, key), type);
-            }
-            else
-            {
-                // get the value
-                return toZval(iter->second->get(base), type);
-            }
+            // read the data member directly, or get the value from the getter
+            if (property) return property->member() ? property->read(base) : toZval(property->get(base), type);
+
+            // retrieve value from the __get method
+            return toZval(meta->callGet(base, key), type);
         }
     }
     catch (const NotImplemented &exception)
@@ -1005,25 +988,29 @@ void ClassImpl::writeProperty(zval *object, zval *name, zval *value, const zend_
         // initialized, which makes it impossible to call Value{name} to convert name to a Php::Value
         if (Z_TYPE_P(name) == IS_STRING)
         {
-            // we need a std::string for the lookup in the std::map
-            std::string key(Z_STRVAL_P(name), Z_STRLEN_P(name));
-
-            // is it a property with a callback?
-            auto iter = impl->_properties.find(key);
+            // is it a property with a callback? (the engine may have calculated the hash already)
+#if PHP_VERSION_ID < 50399
+            Property *property = impl->_properties.find(Z_STRVAL_P(name), Z_STRLEN_P(name));
+#else
+            Property *property = impl->_properties.find(name, key);
+#endif
 
             // is it set?
-            if (iter == impl->_properties.end())
+            if (!property)
             {
                 // use the __set method
-                meta->callSet(base, key, value);
+                meta->callSet(base, Value(Z_STRVAL_P(name), Z_STRLEN_P(name)), value);
             }
             else
             {
+                // data members are written directly
+                if (property->member()) return property->write(base, value);
+
                 // check if it could be set
-                if (iter->second->set(base, value)) return;
+                if (property->set(base, value)) return;
     
                 // read-only property
-                zend_error(E_ERROR, "Unable to write to read-only property %s", key.c_str());
+                zend_error(E_ERROR, "Unable to write to read-only property %s", Z_STRVAL_P(name));
             }
         }
         else
@@ -1032,18 +1019,21 @@ void ClassImpl::writeProperty(zval *object, zval *name, zval *value, const zend_
             Value key(name);
     
             // check if the property has a callback
-            auto iter = impl->_properties.find(key);
+            Property *property = impl->_properties.find(key);
     
             // is it set?
-            if (iter == impl->_properties.end())
+            if (!property)
             {
                 // use the __set method
                 meta->callSet(base, key, value);
             }
             else
             {
+                // data members are written directly
+                if (property->member()) return property->write(base, value);
+
                 // check if it could be set
-                if (iter->second->set(base, value)) return;
+                if (property->set(base, value)) return;
     
                 // read-only property
                 zend_error(E_ERROR, "Unable to write to read-only property %s", (const char *)key);
@@ -1116,14 +1106,15 @@ int ClassImpl::hasProperty(zval *object, zval *name, int has_set_exists, const z
         // which makes it impossible to call Value{name} to convert name to a Php::Value
         if (Z_TYPE_P(name) == IS_STRING)
         {
-            // we need a std::string for the lookup in the std::map
-            std::string property(Z_STRVAL_P(name), Z_STRLEN_P(name));
-            
-            // check if this is a callback property
-            if (impl->_properties.find(property) != impl->_properties.end()) return true;
+            // check if this is a callback property (the engine may have calculated the hash already)
+#if PHP_VERSION_ID < 50399
+            if (impl->_properties.find(Z_STRVAL_P(name), Z_STRLEN_P(name))) return true;
+#else
+            if (impl->_properties.find(name, key)) return true;
+#endif
             
             // we need the to pass a Php::Value to pass to the __isset() and _get() methods
-            Value propvalue(property);
+            Value propvalue(Z_STRVAL_P(name), Z_STRLEN_P(name));
 
             // call the C++ object
             if (!meta->callIsset(base, propvalue)) return false;
@@ -1152,7 +1143,7 @@ int ClassImpl::hasProperty(zval *object, zval *name, int has_set_exists, const z
             Value property(name);
 
             // check if this is a callback property
-            if (impl->_properties.find(property) != impl->_properties.end()) return true;
+            if (impl->_properties.find(property)) return true;
 
             // call the C++ object
             if (!meta->callIsset(base, property)) return false;
@@ -1224,17 +1215,18 @@ void ClassImpl::unsetProperty(zval *object, zval *member, const zend_literal *ke
         // initialized which makes it impossible to call Value{name} to convert name to a Php::Value
         if (Z_TYPE_P(member) == IS_STRING)
         {
-            // we need a std::string for the lookup in the std::map
-            std::string name(Z_STRVAL_P(member), Z_STRLEN_P(member));
-    
-            // is this a callback property?
-            auto iter = impl->_properties.find(name);
+            // is this a callback property? (the engine may have calculated the hash already)
+#if PHP_VERSION_ID < 50399
+            Property *property = impl->_properties.find(Z_STRVAL_P(member), Z_STRLEN_P(member));
+#else
+            Property *property = impl->_properties.find(member, key);
+#endif
     
             // if the property does not exist, we forward to the __unset
-            if (iter == impl->_properties.end()) impl->_base->callUnset(ObjectImpl::find(object TSRMLS_CC)->object(), member);
+            if (!property) return impl->_base->callUnset(ObjectImpl::find(object TSRMLS_CC)->object(), member);
     
             // callback properties cannot be unset
-            zend_error(E_ERROR, "Property %s can not be unset", name.c_str());
+            zend_error(E_ERROR, "Property %s can not be unset", Z_STRVAL_P(member));
         }
         else
         {
@@ -1242,10 +1234,10 @@ void ClassImpl::unsetProperty(zval *object, zval *member, const zend_literal *ke
             Value name(member);
     
             // is this a callback property?
-            auto iter = impl->_properties.find(name);
+            Property *property = impl->_properties.find(name);
     
             // if the property does not exist, we forward to the __unset
-            if (iter == impl->_properties.end()) impl->_base->callUnset(ObjectImpl::find(object TSRMLS_CC)->object(), member);
+            if (!property) return impl->_base->callUnset(ObjectImpl::find(object TSRMLS_CC)->object(), member);
     
             // callback properties cannot be unset
             zend_error(E_ERROR, "Property %s can not be unset", (const char *)name);
@@ -1331,13 +1323,13 @@ zend_object_value ClassImpl::createObject(zend_class_entry *entry TSRMLS_DC)
     // we need the C++ class meta-information object
     ClassImpl *impl = self(entry);
 
-    // create a new base C++ object
-    auto *cpp = impl->_base->construct();
+    // create the object in the zend engine, and the C++ object in the same block of memory
+    ObjectImpl *object = ObjectImpl::construct(entry, impl->_base, impl->_pool TSRMLS_CC);
 
     // report error on failure, because this function is called directly from the
     // Zend engine, we can call zend_error() here (which does a longjmp() back to
     // the Zend engine)
-    if (!cpp) zend_error(E_ERROR, "Unable to instantiate %s", entry->name);
+    if (!object) zend_error(E_ERROR, "Unable to instantiate %s", entry->name);
 
     // the thing we're going to return
     zend_object_value result;
@@ -1345,9 +1337,6 @@ zend_object_value ClassImpl::createObject(zend_class_entry *entry TSRMLS_DC)
     // set the handlers
     result.handlers = impl->objectHandlers();
 
-    // create the object in the zend engine
-    ObjectImpl *object = new ObjectImpl(entry, cpp, 1 TSRMLS_CC);
-
     // store the object in the object cache
     result.handle = object->handle();
 
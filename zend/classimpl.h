@@ -62,10 +62,10 @@ private:
     std::list<std::shared_ptr<Member>> _members;
     
     /**
-     *  Map of dynamically accessible properties
-     *  @var    std::map
+     *  Index of dynamically accessible properties
+     *  @var    PropertyIndex
      */
-    std::map<std::string,std::shared_ptr<Property>> _properties;
+    PropertyIndex _properties;
 
     /**
      *  Interfaces that are implemented
@@ -97,6 +97,12 @@ private:
      */
     char *_self = nullptr;
 
+    /**
+     *  Pool with the memory of destructed objects
+     *  @var    ObjectPool
+     */
+    ObjectPool _pool;
+
     /**
      *  Retrieve an array of zend_function_entry objects that hold the 
      *  properties for each method. This method is called at extension
@@ -470,12 +476,34 @@ public:
      *  @param  getter      Getter method
      *  @param  setter      Setter method
      */
-    void property(const char *name, const getter_callback_0 &getter)                                    { _properties[name] = std::make_shared<Property>(getter); }
-    void property(const char *name, const getter_callback_1 &getter)                                    { _properties[name] = std::make_shared<Property>(getter); }
-    void property(const char *name, const getter_callback_0 &getter, const setter_callback_0 &setter)   { _properties[name] = std::make_shared<Property>(getter,setter); }
-    void property(const char *name, const getter_callback_1 &getter, const setter_callback_0 &setter)   { _properties[name] = std::make_shared<Property>(getter,setter); }
-    void property(const char *name, const getter_callback_0 &getter, const setter_callback_1 &setter)   { _properties[name] = std::make_shared<Property>(getter,setter); }
-    void property(const char *name, const getter_callback_1 &getter, const setter_callback_1 &setter)   { _properties[name] = std::make_shared<Property>(getter,setter); }
+    void property(const char *name, const getter_callback_0 &getter)                                    { _properties.set(name, std::make_shared<Property>(getter)); }
+    void property(const char *name, const getter_callback_1 &getter)                                    { _properties.set(name, std::make_shared<Property>(getter)); }
+    void property(const char *name, const getter_callback_0 &getter, const setter_callback_0 &setter)   { _properties.set(name, std::make_shared<Property>(getter,setter)); }
+    void property(const char *name, const getter_callback_1 &getter, const setter_callback_0 &setter)   { _properties.set(name, std::make_shared<Property>(getter,setter)); }
+    void property(const char *name, const getter_callback_0 &getter, const setter_callback_1 &setter)   { _properties.set(name, std::make_shared<Property>(getter,setter)); }
+    void property(const char *name, const getter_callback_1 &getter, const setter_callback_1 &setter)   { _properties.set(name, std::make_shared<Property>(getter,setter)); }
+
+    /**
+     *  Set property that is bound to a data member
+     *  @param  name        Name of the property
+     *  @param  member      The data member
+     */
+    void property(const char *name, const int_member &member)                                           { _properties.set(name, std::make_shared<Property>(member)); }
+    void property(const char *name, const float_member &member)                                         { _properties.set(name, std::make_shared<Property>(member)); }
+    void property(const char *name, const bool_member &member)                                          { _properties.set(name, std::make_shared<Property>(member)); }
+    void property(const char *name, const string_member &member)                                        { _properties.set(name, std::make_shared<Property>(member)); }
+
+    /**
+     *  Reuse the memory of destructed objects for new objects
+     *  @param  limit       Max number of objects to keep, zero to disable
+     */
+    void pool(size_t limit) { _pool.limit(limit); }
+
+    /**
+     *  Statistics of the memory pool
+     *  @return PoolStatistics
+     */
+    const PoolStatistics &statistics() const { return _pool.statistics(); }
     
     /**
      *  Add an interface that is implemented
@@ -0,0 +1,131 @@
+/**
+ *  Conversion.h
+ *
+ *  Helper class with static methods to convert a zval to a scalar C++ type.
+ *  The conversions follow the same rules as the convert_to_*() functions
+ *  from the Zend engine, but they work directly on the original zval, so
+ *  that no copy of the zval has to be allocated
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2019 Copernica BV
+ */
+
+/**
+ *  Include guard
+ */
+#pragma once
+
+/**
+ *  Begin of namespace
+ */
+namespace Php {
+
+/**
+ *  Class definition
+ */
+class Conversion
+{
+public:
+    /**
+     *  Convert a zval to an integer
+     *  @param  value
+     *  @return int64_t
+     */
+    static int64_t numericValue(zval *value)
+    {
+        // check the type
+        switch (Z_TYPE_P(value)) {
+        case IS_NULL:       return 0;
+        case IS_LONG:       return Z_LVAL_P(value);
+        case IS_BOOL:       return Z_LVAL_P(value);
+        case IS_RESOURCE:   return Z_LVAL_P(value);
+        case IS_DOUBLE:     return zend_dval_to_lval(Z_DVAL_P(value));
+        case IS_STRING:     return strtol(Z_STRVAL_P(value), nullptr, 10);
+        case IS_ARRAY:      return zend_hash_num_elements(Z_ARRVAL_P(value)) ? 1 : 0;
+        }
+
+        // other types (objects) are converted by the engine, on a copy that
+        // lives on the stack
+        zval copy;
+        INIT_PZVAL_COPY(&copy, value);
+        zval_copy_ctor(&copy);
+        convert_to_long(&copy);
+
+        // the copy is now a plain integer
+        return Z_LVAL(copy);
+    }
+
+    /**
+     *  Convert a zval to a floating point number
+     *  @param  value
+     *  @return double
+     */
+    static double floatValue(zval *value)
+    {
+        // check the type
+        switch (Z_TYPE_P(value)) {
+        case IS_NULL:       return 0.0;
+        case IS_LONG:       return (double)Z_LVAL_P(value);
+        case IS_BOOL:       return (double)Z_LVAL_P(value);
+        case IS_RESOURCE:   return (double)Z_LVAL_P(value);
+        case IS_DOUBLE:     return Z_DVAL_P(value);
+        case IS_STRING:     return zend_strtod(Z_STRVAL_P(value), nullptr);
+        case IS_ARRAY:      return zend_hash_num_elements(Z_ARRVAL_P(value)) ? 1.0 : 0.0;
+        }
+
+        // other types (objects) are converted by the engine, on a copy that
+        // lives on the stack
+        zval copy;
+        INIT_PZVAL_COPY(&copy, value);
+        zval_copy_ctor(&copy);
+        convert_to_double(&copy);
+
+        // the copy is now a plain double
+        return Z_DVAL(copy);
+    }
+
+    /**
+     *  Convert a zval to a string
+     *  @param  value
+     *  @return std::string
+     */
+    static std::string stringValue(zval *value)
+    {
+        // strings do not have to be converted
+        if (Z_TYPE_P(value) == IS_STRING) return std::string(Z_STRVAL_P(value), Z_STRLEN_P(value));
+
+        // let zend make a printable copy on the stack, this does not allocate a new zval
+        zval copy;
+        int use_copy = 0;
+        zend_make_printable_zval(value, &copy, &use_copy);
+
+        // if no copy was needed the value is printable as it is
+        if (!use_copy) return std::string(Z_STRVAL_P(value), Z_STRLEN_P(value));
+
+        // copy the string, and clean up the temporary
+        std::string result(Z_STRVAL(copy), Z_STRLEN(copy));
+        zval_dtor(&copy);
+
+        // done
+        return result;
+    }
+
+    /**
+     *  Convert a zval to a boolean
+     *  @param  value
+     *  @return bool
+     */
+    static bool boolValue(zval *value)
+    {
+        // booleans do not have to be converted
+        if (Z_TYPE_P(value) == IS_BOOL) return Z_BVAL_P(value);
+
+        // zend knows how to check this for all types, without modifying the value
+        return zend_is_true(value);
+    }
+};
+
+/**
+ *  End of namespace
+ */
+}
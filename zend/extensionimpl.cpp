@@ -5,6 +5,8 @@
  *  @copyright 2013 Copernica BV
  */
 #include "includes.h"
+#include "methodcache.h"
+#include "calldata.h"
 
 /**
  *  Set up namespace
@@ -175,6 +177,30 @@ int ExtensionImpl::processIdle(int type, int module_number TSRMLS_DC)
     return BOOL2SUCCESS(true);
 }
 
+/**
+ *  Function that is called after the request is ended, when the objects
+ *  of the request have been destructed
+ *  @return int         0 on success
+ */
+int ExtensionImpl::processDeactivate()
+{
+    // the objects are freed after the request shutdown functions have been
+    // called, so only now the memory pools hold all memory of the request
+    ObjectPool::clearAll();
+
+    // the classes of this request may be destructed, so the methods that we
+    // remembered can no longer be used (this is not done when the request
+    // shuts down, because destructors that run after it still use the cache)
+    MethodCache::clear();
+
+    // the structures for calls to __call() are request memory, so they must
+    // go too (but only now, because destructors may still call methods)
+    CallData::clear();
+
+    // done
+    return BOOL2SUCCESS(true);
+}
+
 /**
  *  Function that is called when the PHP engine initializes with a different PHP-CPP
  *  version for the libphpcpp.so file than the version the extension was compiled for
@@ -226,7 +252,7 @@ ExtensionImpl::ExtensionImpl(Extension *data, const char *name, const char *vers
     _entry.globals_size = 0;                                       // size of the global variables
     _entry.globals_ctor = NULL;                                    // constructor for global variables
     _entry.globals_dtor = NULL;                                    // destructor for global variables
-    _entry.post_deactivate_func = NULL;                            // unknown function
+    _entry.post_deactivate_func = &ExtensionImpl::processDeactivate;  // after the objects of the request are destructed
     _entry.module_started = 0;                                     // module is not yet started
     _entry.type = 0;                                               // temporary or persistent module, will be filled by Zend engine
     _entry.handle = NULL;                                          // dlopen() handle, will be filled by Zend engine
@@ -251,6 +277,7 @@ ExtensionImpl::ExtensionImpl(Extension *data, const char *name, const char *vers
     _entry.module_shutdown_func = nullptr;
     _entry.request_startup_func = nullptr;
     _entry.request_shutdown_func = nullptr;
+    _entry.post_deactivate_func = nullptr;
 }
 
 /**
@@ -189,6 +189,13 @@ private:
      */
     static int processIdle(int type, int module_number TSRMLS_DC);
 
+    /**
+     *  Function that is called after the request is ended, when the objects
+     *  of the request have been destructed
+     *  @return int         0 on success
+     */
+    static int processDeactivate();
+
     /**
      *  Function that is called when the PHP engine initializes with a different PHP-CPP
      *  version for the libphpcpp.so file than the version the extension was compiled for
@@ -11,16 +11,23 @@
  *  Include standard C and C++ libraries
  */
 #include <stdlib.h>
+#include <errno.h>
 #include <string>
 #include <initializer_list>
 #include <vector>
 #include <map>
+#include <unordered_map>
 #include <set>
 #include <memory>
 #include <list>
 #include <exception>
 #include <type_traits>
 #include <functional>
+#include <tuple>
+#include <algorithm>
+#include <limits>
+#include <iterator>
+#include <stdexcept>
 
 // for debug
 #include <iostream>
@@ -76,10 +83,16 @@
 #include "../include/streams.h"
 #include "../include/type.h"
 #include "../include/message.h"
+#include "../include/stringview.h"
+#include "../include/key.h"
 #include "../include/hashparent.h"
 #include "../include/value.h"
+#include "../include/localvalue.h"
+#include "../include/valueref.h"
+#include "../include/stringbuilder.h"
 #include "../include/valueiterator.h"
 #include "../include/array.h"
+#include "../include/arraybuilder.h"
 #include "../include/object.h"
 #include "../include/globals.h"
 #include "../include/argument.h"
@@ -88,6 +101,7 @@
 #include "../include/global.h"
 #include "../include/hashmember.h"
 #include "../include/super.h"
+#include "../include/smallvector.h"
 #include "../include/parameters.h"
 #include "../include/modifiers.h"
 #include "../include/base.h"
@@ -97,14 +111,19 @@
 #include "../include/iterator.h"
 #include "../include/traversable.h"
 #include "../include/classtype.h"
+#include "../include/poolstatistics.h"
 #include "../include/classbase.h"
 #include "../include/interface.h"
 #include "../include/constant.h"
 #include "../include/zendcallable.h"
+#include "../include/typedfunction.h"
 #include "../include/class.h"
 #include "../include/namespace.h"
 #include "../include/extension.h"
 #include "../include/call.h"
+#include "../include/callsite.h"
+#include "../include/binary.h"
+#include "../include/json.h"
 #include "../include/script.h"
 #include "../include/file.h"
 #include "../include/function.h"
@@ -119,7 +138,6 @@
 /**
  *  Specific zend implementation  files for internal use only
  */
-#include "hiddenpointer.h"
 #include "init.h"
 #include "callable.h"
 #include "nativefunction.h"
@@ -134,11 +152,13 @@
 #include "origexception.h"
 #include "notimplemented.h"
 #include "property.h"
+#include "propertyindex.h"
 #include "valueiteratorimpl.h"
 #include "hashiterator.h"
 #include "invaliditerator.h"
 #include "traverseiterator.h"
 #include "iteratorimpl.h"
+#include "objectpool.h"
 #include "classimpl.h"
 #include "objectimpl.h"
 #include "parametersimpl.h"
@@ -148,7 +168,6 @@
 #include "opcodes.h"
 #include "functor.h"
 #include "constantimpl.h"
-#include "delayedfree.h"
 #include "extensionpath.h"
 #include "symbol.h"
 #include "module.h"
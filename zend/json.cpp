@@ -0,0 +1,283 @@
+/**
+ *  Json.cpp
+ *
+ *  Implementation of the json_encode() and json_decode() functions
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2019 Copernica BV
+ */
+#include "includes.h"
+#include "jsonencoder.h"
+#include "jsondecoder.h"
+#include "utf8.h"
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Output that collects the JSON in a string builder
+ */
+class JsonStringOutput
+{
+private:
+    /**
+     *  The builder
+     *  @var StringBuilder
+     */
+    StringBuilder _builder;
+
+public:
+    /**
+     *  Append data
+     *  @param  data
+     *  @param  size
+     */
+    void append(const char *data, size_t size) { _builder.append(data, size); }
+    void append(char data) { _builder.append(data); }
+
+    /**
+     *  Expose the collected string
+     *  @return Value
+     */
+    Value value() { return _builder.value(); }
+};
+
+/**
+ *  Output that writes the JSON to a stream
+ */
+class JsonStreamOutput
+{
+private:
+    /**
+     *  The stream
+     *  @var std::ostream
+     */
+    std::ostream &_stream;
+
+public:
+    /**
+     *  Constructor
+     *  @param  stream
+     */
+    JsonStreamOutput(std::ostream &stream) : _stream(stream) {}
+
+    /**
+     *  Append data
+     *  @param  data
+     *  @param  size
+     */
+    void append(const char *data, size_t size) { _stream.write(data, size); }
+    void append(char data) { _stream.put(data); }
+};
+
+/**
+ *  Input that reads from a buffer
+ */
+class JsonBufferInput
+{
+private:
+    /**
+     *  The current position and the end of the buffer
+     *  @var const char *
+     */
+    const char *_pos;
+    const char *_end;
+
+public:
+    /**
+     *  Constructor
+     *  @param  buffer
+     *  @param  size
+     */
+    JsonBufferInput(const char *buffer, size_t size) : _pos(buffer), _end(buffer + size) {}
+
+    /**
+     *  The next character, or -1 at the end of the input
+     *  @return int
+     */
+    int peek() const { return _pos < _end ? (unsigned char)*_pos : -1; }
+
+    /**
+     *  Consume the next character
+     *  @return int
+     */
+    int get() { return _pos < _end ? (unsigned char)*_pos++ : -1; }
+
+    /**
+     *  Copy the characters of a string that need no special treatment, in one
+     *  go (this throws an exception for malformed UTF-8)
+     *  @param  output
+     */
+    void scan(std::string &output)
+    {
+        // find the end of the run
+        const char *start = _pos;
+        while (_pos < _end)
+        {
+            // the next character
+            unsigned char c = *_pos;
+
+            // stop at characters that need attention
+            if (c == '"' || c == '\\' || c < 0x20) break;
+
+            // ascii characters need no further checks
+            if (c < 0x80) { ++_pos; continue; }
+
+            // check the multi-byte character, and skip it
+            auto *current = (const unsigned char *)_pos;
+            utf8(current, (const unsigned char *)_end);
+            _pos = (const char *)current;
+        }
+
+        // copy the run
+        output.append(start, _pos - start);
+    }
+};
+
+/**
+ *  Input that reads from a stream
+ */
+class JsonStreamInput
+{
+private:
+    /**
+     *  The buffer of the stream
+     *  @var std::streambuf
+     */
+    std::streambuf *_buffer;
+
+public:
+    /**
+     *  Constructor
+     *  @param  stream
+     */
+    JsonStreamInput(std::istream &stream) : _buffer(stream.rdbuf()) {}
+
+    /**
+     *  The next character, or -1 at the end of the input
+     *  @return int
+     */
+    int peek() const
+    {
+        // check the buffer
+        if (!_buffer) return -1;
+        auto c = _buffer->sgetc();
+        return c == std::streambuf::traits_type::eof() ? -1 : c;
+    }
+
+    /**
+     *  Consume the next character
+     *  @return int
+     */
+    int get()
+    {
+        // check the buffer
+        if (!_buffer) return -1;
+        auto c = _buffer->sbumpc();
+        return c == std::streambuf::traits_type::eof() ? -1 : c;
+    }
+
+    /**
+     *  Copy the characters of a string that need no special treatment (this
+     *  throws an exception for malformed UTF-8)
+     *  @param  output
+     */
+    void scan(std::string &output)
+    {
+        // copy characters until one is found that needs attention
+        while (true)
+        {
+            // the next character
+            int c = peek();
+            if (c < 0x20 || c == '"' || c == '\\') return;
+
+            // ascii characters can be copied right away
+            if (c < 0x80) { output.push_back((char)_buffer->sbumpc()); continue; }
+
+            // the number of continuation bytes that should follow
+            int count = (c & 0xe0) == 0xc0 ? 1 : (c & 0xf0) == 0xe0 ? 2 : (c & 0xf8) == 0xf0 ? 3 : 0;
+
+            // collect the first byte and the continuation bytes that are there
+            unsigned char buffer[4];
+            size_t size = 0;
+            buffer[size++] = (unsigned char)_buffer->sbumpc();
+            while ((int)size <= count && (peek() & 0xc0) == 0x80) buffer[size++] = (unsigned char)_buffer->sbumpc();
+
+            // check the character
+            const unsigned char *current = buffer;
+            utf8(current, buffer + size);
+
+            // copy it
+            output.append((const char *)buffer, size);
+        }
+    }
+};
+
+/**
+ *  Turn a value into JSON
+ *  @param  value       The value to encode
+ *  @return Value       String holding the JSON
+ */
+Value json_encode(const Value &value)
+{
+    // the output
+    JsonStringOutput output;
+
+    // encode the value
+    JsonEncoder<JsonStringOutput>(output).encode(value);
+
+    // expose the output
+    return output.value();
+}
+
+/**
+ *  Write a value as JSON to a stream
+ *  @param  value       The value to encode
+ *  @param  stream      The stream to write to
+ */
+void json_encode(const Value &value, std::ostream &stream)
+{
+    // the output
+    JsonStreamOutput output(stream);
+
+    // encode the value
+    JsonEncoder<JsonStreamOutput>(output).encode(value);
+}
+
+/**
+ *  Parse JSON into a value
+ *  @param  buffer      The JSON
+ *  @param  size        Size of the JSON
+ *  @param  assoc       Turn objects into associative arrays
+ *  @return Value
+ */
+Value json_decode(const char *buffer, size_t size, bool assoc)
+{
+    // the input
+    JsonBufferInput input(buffer, size);
+
+    // decode the input
+    return JsonDecoder<JsonBufferInput>(input, assoc).decode();
+}
+
+/**
+ *  Parse JSON from a stream into a value
+ *  @param  stream      The stream to read from
+ *  @param  assoc       Turn objects into associative arrays
+ *  @return Value
+ */
+Value json_decode(std::istream &stream, bool assoc)
+{
+    // the input
+    JsonStreamInput input(stream);
+
+    // decode the input
+    return JsonDecoder<JsonStreamInput>(input, assoc).decode();
+}
+
+/**
+ *  End of namespace
+ */
+}
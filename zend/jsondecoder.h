@@ -0,0 +1,539 @@
+/**
+ *  JsonDecoder.h
+ *
+ *  Class that parses JSON into a value. The input is read from an input
+ *  object with peek(), get() and scan() methods, so that the same parser
+ *  can read from a buffer and from a stream.
+ *
+ *  Arrays and objects are first collected in a vector, so that the hash
+ *  table can be created at its final size once the number of elements is
+ *  known. The vectors are reused for all arrays at the same depth.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2019 Copernica BV
+ */
+
+/**
+ *  Include guard
+ */
+#pragma once
+
+/**
+ *  Begin of namespace
+ */
+namespace Php {
+
+/**
+ *  Class definition
+ */
+template <typename Input>
+class JsonDecoder
+{
+private:
+    /**
+     *  The input
+     *  @var Input
+     */
+    Input &_input;
+
+    /**
+     *  Should objects be turned into associative arrays?
+     *  @var bool
+     */
+    bool _assoc;
+
+    /**
+     *  Maximum depth of nested arrays and objects (same as PHP)
+     */
+    static const int maxdepth = 512;
+
+    /**
+     *  The elements that are collected per depth, and the keys of those elements
+     *  @var std::vector
+     */
+    std::vector<std::vector<Value>> _values;
+    std::vector<std::vector<std::string>> _keys;
+
+    /**
+     *  Buffer to collect numbers in (reused for all numbers)
+     *  @var std::string
+     */
+    std::string _number;
+
+    /**
+     *  Helper function to report invalid input
+     */
+    static void invalid()
+    {
+        throw Exception("Syntax error");
+    }
+
+    /**
+     *  Skip whitespace, and return the next character (without consuming it)
+     *  @return int
+     */
+    int next()
+    {
+        // skip all whitespace
+        while (true)
+        {
+            // check the next character
+            int c = _input.peek();
+            if (c != ' ' && c != '\t' && c != '\n' && c != '\r') return c;
+
+            // skip it
+            _input.get();
+        }
+    }
+
+    /**
+     *  Consume a character that must be there
+     *  @param  c
+     */
+    void expect(int c)
+    {
+        // check the character
+        if (_input.get() != c) invalid();
+    }
+
+    /**
+     *  Consume a literal word
+     *  @param  word
+     */
+    void literal(const char *word)
+    {
+        // check all characters
+        for (; *word; ++word) expect(*word);
+    }
+
+    /**
+     *  Read four hexadecimal digits
+     *  @return uint32_t
+     */
+    uint32_t hex()
+    {
+        // the result
+        uint32_t result = 0;
+
+        // read the digits
+        for (int i = 0; i < 4; ++i)
+        {
+            // the next digit
+            int c = _input.get();
+
+            // add its value
+            if (c >= '0' && c <= '9') result = (result << 4) | (c - '0');
+            else if (c >= 'a' && c <= 'f') result = (result << 4) | (c - 'a' + 10);
+            else if (c >= 'A' && c <= 'F') result = (result << 4) | (c - 'A' + 10);
+            else invalid();
+        }
+
+        // done
+        return result;
+    }
+
+    /**
+     *  Append a code point in UTF-8 to a string
+     *  @param  output
+     *  @param  codepoint
+     */
+    static void utf8(std::string &output, uint32_t codepoint)
+    {
+        // the number of bytes depends on the size of the code point
+        if (codepoint < 0x80) output.push_back((char)codepoint);
+        else if (codepoint < 0x800)
+        {
+            output.push_back((char)(0xc0 | (codepoint >> 6)));
+            output.push_back((char)(0x80 | (codepoint & 0x3f)));
+        }
+        else if (codepoint < 0x10000)
+        {
+            output.push_back((char)(0xe0 | (codepoint >> 12)));
+            output.push_back((char)(0x80 | ((codepoint >> 6) & 0x3f)));
+            output.push_back((char)(0x80 | (codepoint & 0x3f)));
+        }
+        else
+        {
+            output.push_back((char)(0xf0 | (codepoint >> 18)));
+            output.push_back((char)(0x80 | ((codepoint >> 12) & 0x3f)));
+            output.push_back((char)(0x80 | ((codepoint >> 6) & 0x3f)));
+            output.push_back((char)(0x80 | (codepoint & 0x3f)));
+        }
+    }
+
+    /**
+     *  Read a string (the opening quote was already consumed)
+     *  @param  output
+     */
+    void string(std::string &output)
+    {
+        // start with an empty string
+        output.clear();
+
+        // read until the closing quote
+        while (true)
+        {
+            // copy all characters that are not special in one go
+            _input.scan(output);
+
+            // the character that stopped the scan
+            int c = _input.get();
+
+            // is this the end of the string?
+            if (c == '"') return;
+
+            // control characters (and the end of the input) are not allowed
+            if (c != '\\') invalid();
+
+            // check the escaped character
+            switch (_input.get()) {
+            case '"':   output.push_back('"'); break;
+            case '\\':  output.push_back('\\'); break;
+            case '/':   output.push_back('/'); break;
+            case 'b':   output.push_back('\b'); break;
+            case 'f':   output.push_back('\f'); break;
+            case 'n':   output.push_back('\n'); break;
+            case 'r':   output.push_back('\r'); break;
+            case 't':   output.push_back('\t'); break;
+            case 'u':   unicode(output); break;
+            default:    invalid();
+            }
+        }
+    }
+
+    /**
+     *  Read an escaped unicode character (the \u was already consumed)
+     *  @param  output
+     */
+    void unicode(std::string &output)
+    {
+        // read the code point
+        uint32_t codepoint = hex();
+
+        // is this the first part of a surrogate pair?
+        if (codepoint >= 0xd800 && codepoint < 0xdc00)
+        {
+            // the second part must follow
+            expect('\\');
+            expect('u');
+            uint32_t low = hex();
+
+            // it must be a low surrogate
+            if (low < 0xdc00 || low >= 0xe000) invalid();
+
+            // combine the pair
+            codepoint = 0x10000 + ((codepoint - 0xd800) << 10) + (low - 0xdc00);
+        }
+
+        // a low surrogate without a high surrogate is not valid
+        else if (codepoint >= 0xdc00 && codepoint < 0xe000) invalid();
+
+        // write the character
+        utf8(output, codepoint);
+    }
+
+    /**
+     *  Read a number
+     *  @return Value
+     */
+    Value number()
+    {
+        // start with an empty buffer
+        _number.clear();
+
+        // is this a floating point number?
+        bool floating = false;
+
+        // collect the characters that can be part of a number
+        while (true)
+        {
+            // the next character
+            int c = _input.peek();
+
+            // check if it is part of the number
+            if (c == '.' || c == 'e' || c == 'E') floating = true;
+            else if ((c < '0' || c > '9') && c != '-' && c != '+') break;
+
+            // add the character
+            _number.push_back((char)_input.get());
+        }
+
+        // the number as a null terminated string
+        const char *buffer = _number.c_str();
+
+        // check the syntax
+        if (!valid(buffer)) invalid();
+
+        // integers that fit in a long are stored as integers
+        if (!floating)
+        {
+            // parse the integer
+            errno = 0;
+            long result = strtol(buffer, nullptr, 10);
+
+            // it should not overflow
+            if (errno != ERANGE) return (int64_t)result;
+        }
+
+        // all other numbers are floating point numbers
+        return zend_strtod(buffer, nullptr);
+    }
+
+    /**
+     *  Check the syntax of a number
+     *  @param  number
+     *  @return bool
+     */
+    static bool valid(const char *number)
+    {
+        // optional minus sign
+        if (*number == '-') ++number;
+
+        // the integer part: a zero, or digits that do not start with a zero
+        if (*number == '0') ++number;
+        else if (*number >= '1' && *number <= '9') while (*number >= '0' && *number <= '9') ++number;
+        else return false;
+
+        // the optional fraction
+        if (*number == '.')
+        {
+            // at least one digit
+            if (*++number < '0' || *number > '9') return false;
+            while (*number >= '0' && *number <= '9') ++number;
+        }
+
+        // the optional exponent
+        if (*number == 'e' || *number == 'E')
+        {
+            // optional sign
+            if (*++number == '+' || *number == '-') ++number;
+
+            // at least one digit
+            if (*number < '0' || *number > '9') return false;
+            while (*number >= '0' && *number <= '9') ++number;
+        }
+
+        // there should be nothing left
+        return *number == '\0';
+    }
+
+    /**
+     *  Read an array (the opening bracket was already consumed)
+     *  @param  depth
+     *  @return Value
+     */
+    Value array(int depth)
+    {
+        // the elements at this depth
+        if (_values.size() <= (size_t)depth) _values.resize(depth + 1);
+        _values[depth].clear();
+
+        // read the elements
+        if (next() == ']') _input.get();
+        else while (true)
+        {
+            // read the element (nested arrays may resize the outer vector,
+            // so the vector for this depth is looked up again afterwards)
+            Value value = read(depth + 1);
+            _values[depth].push_back(std::move(value));
+
+            // check what comes next
+            int c = next();
+            _input.get();
+            if (c == ']') break;
+            if (c != ',') invalid();
+        }
+
+        // the elements (nested arrays may have resized the outer vector)
+        auto &elements = _values[depth];
+
+        // create the array at its final size
+        Value result(Type::Array);
+        result.reserveArray(elements.size());
+
+        // add all elements
+        for (auto &element : elements) add_next_index_zval(result._val, element.detach(true));
+
+        // the values have been moved into the array
+        elements.clear();
+
+        // done
+        return result;
+    }
+
+    /**
+     *  Read an object (the opening brace was already consumed)
+     *  @param  depth
+     *  @return Value
+     */
+    Value object(int depth)
+    {
+        // the members at this depth
+        if (_values.size() <= (size_t)depth) _values.resize(depth + 1);
+        if (_keys.size() <= (size_t)depth) _keys.resize(depth + 1);
+
+        // start empty
+        _values[depth].clear();
+        size_t count = 0;
+
+        // read the members
+        if (next() == '}') _input.get();
+        else while (true)
+        {
+            // the key should be a string
+            if (next() != '"') invalid();
+            _input.get();
+
+            // reuse the strings in the vector, so that their buffers are reused too
+            if (_keys[depth].size() <= count) _keys[depth].resize(count + 1);
+            string(_keys[depth][count]);
+
+            // the separator
+            if (next() != ':') invalid();
+            _input.get();
+
+            // read the value
+            Value value = read(depth + 1);
+            _values[depth].push_back(std::move(value));
+            ++count;
+
+            // check what comes next
+            int c = next();
+            _input.get();
+            if (c == '}') break;
+            if (c != ',') invalid();
+        }
+
+        // the keys and values (nested objects may have resized the outer vectors)
+        auto &keys = _keys[depth];
+        auto &values = _values[depth];
+
+        // build the result
+        Value result = _assoc ? associative(keys, values) : properties(keys, values);
+
+        // the values have been moved
+        values.clear();
+
+        // done
+        return result;
+    }
+
+    /**
+     *  Build an associative array
+     *  @param  keys
+     *  @param  values
+     *  @return Value
+     */
+    Value associative(std::vector<std::string> &keys, std::vector<Value> &values)
+    {
+        // create the array at its final size
+        Value result(Type::Array);
+        result.reserveArray(values.size());
+
+        // add the members (numeric keys become numeric, and later keys overwrite earlier ones)
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            // the value to add
+            zval *value = values[i].detach(true);
+
+            // add it
+            zend_symtable_update(Z_ARRVAL_P(result._val), keys[i].c_str(), keys[i].size() + 1, (void *)&value, sizeof(zval *), nullptr);
+        }
+
+        // done
+        return result;
+    }
+
+    /**
+     *  Build a stdClass object
+     *  @param  keys
+     *  @param  values
+     *  @return Value
+     */
+    Value properties(std::vector<std::string> &keys, std::vector<Value> &values)
+    {
+        // create the object
+        Value result(Type::Object);
+
+        // add the members
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            // the key
+            auto &key = keys[i];
+
+            // properties can not start with a null byte
+            if (!key.empty() && key[0] == '\0') throw Exception("The decoded property name is invalid");
+
+            // PHP uses a special name for empty keys
+            if (key.empty()) result.set("_empty_", 7, values[i]);
+            else result.set(key.c_str(), key.size(), values[i]);
+        }
+
+        // done
+        return result;
+    }
+
+    /**
+     *  Read a value
+     *  @param  depth
+     *  @return Value
+     */
+    Value read(int depth)
+    {
+        // check the depth
+        if (depth > maxdepth) throw Exception("Maximum stack depth exceeded");
+
+        // the first character tells what kind of value follows
+        switch (next()) {
+        case '{':   _input.get(); return object(depth);
+        case '[':   _input.get(); return array(depth);
+        case '"':   { _input.get(); std::string value; string(value); return value; }
+        case 't':   literal("true"); return true;
+        case 'f':   literal("false"); return false;
+        case 'n':   literal("null"); return nullptr;
+        case '-':   return number();
+        default:    break;
+        }
+
+        // the only thing left are numbers
+        int c = next();
+        if (c < '0' || c > '9') invalid();
+
+        // read the number
+        return number();
+    }
+
+public:
+    /**
+     *  Constructor
+     *  @param  input       The input
+     *  @param  assoc       Turn objects into associative arrays
+     */
+    JsonDecoder(Input &input, bool assoc) : _input(input), _assoc(assoc) {}
+
+    /**
+     *  Destructor
+     */
+    virtual ~JsonDecoder() = default;
+
+    /**
+     *  Parse the input
+     *  @return Value
+     */
+    Value decode()
+    {
+        // read the value
+        Value result = read(0);
+
+        // there should be nothing left but whitespace
+        if (next() != -1) invalid();
+
+        // done
+        return result;
+    }
+};
+
+/**
+ *  End of namespace
+ */
+}
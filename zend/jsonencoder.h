@@ -0,0 +1,355 @@
+/**
+ *  JsonEncoder.h
+ *
+ *  Class that writes a value as JSON. The output is written to an output
+ *  object that has an append() method for characters and for buffers, so
+ *  that the same encoder can write into a string builder and into a stream.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2019 Copernica BV
+ */
+
+/**
+ *  Include guard
+ */
+#pragma once
+
+/**
+ *  Dependencies
+ */
+#include "utf8.h"
+
+/**
+ *  Begin of namespace
+ */
+namespace Php {
+
+/**
+ *  Class that marks a hash table as being written for as long as it is in
+ *  scope, so that the encoder detects recursion (also when an exception
+ *  is thrown while the table is being written)
+ */
+class JsonRecursion
+{
+private:
+    /**
+     *  The table that is being written
+     *  @var HashTable
+     */
+    HashTable *_table;
+
+public:
+    /**
+     *  Constructor
+     *  @param  table
+     */
+    JsonRecursion(HashTable *table) : _table(table) { _table->nApplyCount++; }
+
+    /**
+     *  Destructor
+     */
+    ~JsonRecursion() { _table->nApplyCount--; }
+};
+
+/**
+ *  Class definition
+ */
+template <typename Output>
+class JsonEncoder
+{
+private:
+    /**
+     *  The output
+     *  @var Output
+     */
+    Output &_output;
+
+    /**
+     *  Maximum depth of nested arrays and objects (same as PHP)
+     */
+    static const int maxdepth = 512;
+
+    /**
+     *  Write a string
+     *  @param  data
+     *  @param  size
+     */
+    void string(const char *data, size_t size)
+    {
+        // hexadecimal digits
+        static const char *digits = "0123456789abcdef";
+
+        // the opening quote
+        _output.append('"');
+
+        // the end of the string
+        const unsigned char *current = (const unsigned char *)data;
+        const unsigned char *end = current + size;
+
+        // write the string
+        while (current < end)
+        {
+            // first find a run of characters that do not have to be escaped
+            const unsigned char *start = current;
+            while (current < end && *current >= 0x20 && *current < 0x80 && *current != '"' && *current != '\\' && *current != '/') ++current;
+
+            // write the run in one go
+            if (current > start) _output.append((const char *)start, current - start);
+
+            // are we done?
+            if (current == end) break;
+
+            // check the character that should be escaped
+            switch (*current) {
+            case '"':   _output.append("\\\"", 2); ++current; continue;
+            case '\\':  _output.append("\\\\", 2); ++current; continue;
+            case '/':   _output.append("\\/", 2); ++current; continue;
+            case '\b':  _output.append("\\b", 2); ++current; continue;
+            case '\f':  _output.append("\\f", 2); ++current; continue;
+            case '\n':  _output.append("\\n", 2); ++current; continue;
+            case '\r':  _output.append("\\r", 2); ++current; continue;
+            case '\t':  _output.append("\\t", 2); ++current; continue;
+            }
+
+            // decode the unicode code point
+            uint32_t codepoint = utf8(current, end);
+
+            // characters outside the basic plane are written as a surrogate pair
+            if (codepoint >= 0x10000)
+            {
+                // write the high surrogate, and continue with the low surrogate
+                codepoint -= 0x10000;
+                uint32_t high = 0xd800 | (codepoint >> 10);
+                char buffer[6] = { '\\', 'u', digits[high >> 12], digits[(high >> 8) & 0xf], digits[(high >> 4) & 0xf], digits[high & 0xf] };
+                _output.append(buffer, 6);
+                codepoint = 0xdc00 | (codepoint & 0x3ff);
+            }
+
+            // write the escaped character
+            char buffer[6] = { '\\', 'u', digits[codepoint >> 12], digits[(codepoint >> 8) & 0xf], digits[(codepoint >> 4) & 0xf], digits[codepoint & 0xf] };
+            _output.append(buffer, 6);
+        }
+
+        // the closing quote
+        _output.append('"');
+    }
+
+    /**
+     *  Write an integer
+     *  @param  value
+     */
+    void integer(long value)
+    {
+        // write the number
+        char buffer[32];
+        _output.append(buffer, snprintf(buffer, sizeof(buffer), "%ld", value));
+    }
+
+    /**
+     *  Write a floating point number
+     *  @param  value
+     */
+    void floating(double value)
+    {
+        // infinite numbers can not be written in json, PHP writes a zero
+        if (zend_isinf(value) || zend_isnan(value)) return _output.append('0');
+
+        // we need the tsrm_ls variable
+        TSRMLS_FETCH();
+
+        // PHP uses the "precision" setting for json
+        int precision = EG(precision) > 0 ? (int)EG(precision) : 17;
+
+        // write the number, the same way as PHP does it
+        char buffer[NUM_BUF_SIZE];
+        php_gcvt(value, precision, '.', 'e', buffer);
+        _output.append(buffer, ::strlen(buffer));
+    }
+
+    /**
+     *  Check if a hash table is a list (keys 0, 1, 2 in order)
+     *  @param  table
+     *  @return bool
+     */
+    static bool list(HashTable *table)
+    {
+        // the expected index
+        unsigned long index = 0;
+
+        // check all buckets
+        for (Bucket *bucket = table->pListHead; bucket; bucket = bucket->pListNext, ++index)
+        {
+            // keys must be numeric, and in order
+            if (bucket->nKeyLength > 0 || bucket->h != index) return false;
+        }
+
+        // it is a list
+        return true;
+    }
+
+    /**
+     *  Write an array
+     *  @param  table
+     *  @param  depth
+     */
+    void array(HashTable *table, int depth)
+    {
+        // check the depth
+        if (depth >= maxdepth) throw Exception("Maximum stack depth exceeded");
+
+        // recursive arrays can not be encoded
+        if (table->nApplyCount > 0) throw Exception("Recursion detected");
+
+        // lists are written as json arrays
+        if (list(table))
+        {
+            // protect against recursion
+            JsonRecursion recursion(table);
+
+            // write the elements
+            _output.append('[');
+            for (Bucket *bucket = table->pListHead; bucket; bucket = bucket->pListNext)
+            {
+                // separate the elements
+                if (bucket != table->pListHead) _output.append(',');
+
+                // write the element
+                write(*(zval **)bucket->pData, depth + 1);
+            }
+            _output.append(']');
+        }
+        else
+        {
+            // other arrays are written as objects
+            members(table, depth, false);
+        }
+    }
+
+    /**
+     *  Write the members of an array or object as a json object
+     *  @param  table
+     *  @param  depth
+     *  @param  object      Is this the property table of an object?
+     */
+    void members(HashTable *table, int depth, bool object)
+    {
+        // protect against recursion
+        JsonRecursion recursion(table);
+
+        // write the elements
+        _output.append('{');
+
+        // is this the first member?
+        bool first = true;
+
+        // write all members
+        for (Bucket *bucket = table->pListHead; bucket; bucket = bucket->pListNext)
+        {
+            // private and protected properties start with a null byte, these are skipped
+            if (object && bucket->nKeyLength > 0 && bucket->arKey[0] == '\0') continue;
+
+            // separate the members
+            if (!first) _output.append(',');
+            first = false;
+
+            // write the key
+            if (bucket->nKeyLength == 0)
+            {
+                // numeric keys are written as a string
+                _output.append('"');
+                integer((long)bucket->h);
+                _output.append('"');
+            }
+            else string(bucket->arKey, bucket->nKeyLength - 1);
+
+            // write the value
+            _output.append(':');
+            write(*(zval **)bucket->pData, depth + 1);
+        }
+
+        // done
+        _output.append('}');
+    }
+
+    /**
+     *  Write an object
+     *  @param  value
+     *  @param  depth
+     */
+    void object(zval *value, int depth)
+    {
+        // check the depth
+        if (depth >= maxdepth) throw Exception("Maximum stack depth exceeded");
+
+        // wrap the object, so that we can use the regular api
+        Value object(value);
+
+        // objects can implement their own serialization
+        if (object.instanceOf("JsonSerializable"))
+        {
+            // serialize the result of jsonSerialize() instead
+            Value result = object.call("jsonSerialize");
+
+            // write that result, unless the object returned itself, in that
+            // case its properties are written (just like json_encode() does)
+            if (Z_TYPE_P(result._val) != IS_OBJECT || Z_OBJ_HANDLE_P(result._val) != Z_OBJ_HANDLE_P(value)) return write(result._val, depth + 1);
+        }
+
+        // objects without properties
+        HashTable *table = Z_OBJ_HT_P(value)->get_properties ? Z_OBJPROP_P(value) : nullptr;
+        if (!table) return _output.append("{}", 2);
+
+        // recursive objects can not be encoded
+        if (table->nApplyCount > 0) throw Exception("Recursion detected");
+
+        // write the public properties
+        members(table, depth, true);
+    }
+
+    /**
+     *  Write a value
+     *  @param  value
+     *  @param  depth
+     */
+    void write(zval *value, int depth)
+    {
+        // check the type
+        switch (Z_TYPE_P(value)) {
+        case IS_NULL:       return _output.append("null", 4);
+        case IS_BOOL:       return Z_BVAL_P(value) ? _output.append("true", 4) : _output.append("false", 5);
+        case IS_LONG:       return integer(Z_LVAL_P(value));
+        case IS_DOUBLE:     return floating(Z_DVAL_P(value));
+        case IS_STRING:     return string(Z_STRVAL_P(value), Z_STRLEN_P(value));
+        case IS_ARRAY:      return array(Z_ARRVAL_P(value), depth);
+        case IS_OBJECT:     return object(value, depth);
+        default:            throw Exception("Type is not supported");
+        }
+    }
+
+public:
+    /**
+     *  Constructor
+     *  @param  output      The output to write to
+     */
+    JsonEncoder(Output &output) : _output(output) {}
+
+    /**
+     *  Destructor
+     */
+    ~JsonEncoder() {}
+
+    /**
+     *  Write a value
+     *  @param  value
+     */
+    void encode(const Value &value)
+    {
+        // write the value
+        write(value._val, 0);
+    }
+};
+
+/**
+ *  End of namespace
+ */
+}
@@ -0,0 +1,82 @@
+/**
+ *  Key.cpp
+ *
+ *  Implementation of the Key class
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2019 Copernica BV
+ */
+#include "includes.h"
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Helper function to check if a string is used by zend as a numeric key,
+ *  this follows the same rules as the ZEND_HANDLE_NUMERIC macro: an optional
+ *  minus sign followed by digits, without leading zeros, and strictly between
+ *  LONG_MIN and LONG_MAX
+ *  @param  key         The key
+ *  @param  size        Size of the key
+ *  @param  index       Pointer to the index that is filled
+ *  @return bool
+ */
+static bool numeric(const char *key, size_t size, unsigned long *index)
+{
+    // the end of the key
+    const char *end = key + size;
+
+    // skip the sign
+    bool negative = size > 0 && *key == '-';
+    const char *digits = negative ? key + 1 : key;
+
+    // there must be at least one digit, and not too many of them
+    if (digits == end || end - digits > MAX_LENGTH_OF_LONG - 1) return false;
+
+    // leading zeros are not allowed (and neither is "-0")
+    if (*digits == '0' && (end - digits > 1 || negative)) return false;
+
+    // all characters must be digits
+    for (const char *p = digits; p < end; ++p) if (*p < '0' || *p > '9') return false;
+
+    // parse the number, and check that it did not overflow
+    errno = 0;
+    long result = strtol(key, nullptr, 10);
+    if (errno == ERANGE) return false;
+
+    // zend keeps the extremes of the range as string keys too
+    if (negative ? result == LONG_MIN : result == LONG_MAX) return false;
+
+    // store the index
+    *index = (unsigned long)result;
+
+    // done
+    return true;
+}
+
+/**
+ *  Constructor
+ *  @param  key         The key
+ *  @param  size        Size of the key
+ */
+Key::Key(const char *key, size_t size) : _key(key, size), _numeric(false)
+{
+    // strings that look like a number are stored by zend as numeric keys
+    if (numeric(_key.c_str(), _key.size(), &_hash)) _numeric = true;
+
+    // calculate the hash, zend includes the terminating null byte in the key length
+    else _hash = zend_get_hash_value(_key.c_str(), _key.size() + 1);
+}
+
+/**
+ *  Constructor for a numeric key
+ *  @param  index       The index
+ */
+Key::Key(int64_t index) : _key(std::to_string(index)), _hash((long)index), _numeric(true) {}
+
+/**
+ *  End of namespace
+ */
+}
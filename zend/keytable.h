@@ -0,0 +1,89 @@
+/**
+ *  KeyTable.h
+ *
+ *  Helper functions to access a zend hash table with a Php::Key. Keys are
+ *  either numeric (this includes strings like "12" that zend stores as a
+ *  number) or strings with a precomputed hash, and these functions pick the
+ *  right zend function for each of them, so that the caller does not have to.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2019 Copernica BV
+ */
+
+/**
+ *  Include guard
+ */
+#pragma once
+
+/**
+ *  Begin of namespace
+ */
+namespace Php {
+
+/**
+ *  Check if a key exists in a hash table
+ *  @param  table       The hash table
+ *  @param  key         The key to look for
+ *  @return bool
+ */
+inline bool exists(HashTable *table, const Key &key)
+{
+    // numeric keys are stored by their index
+    if (key.isNumeric()) return zend_hash_index_exists(table, key.hash());
+
+    // string keys are found without hashing them again
+    return zend_hash_quick_exists(table, key.data(), key.size() + 1, key.hash());
+}
+
+/**
+ *  Find an element in a hash table
+ *  @param  table       The hash table
+ *  @param  key         The key to look for
+ *  @return zval**      The element, or nullptr when it does not exist
+ */
+inline zval **find(HashTable *table, const Key &key)
+{
+    // the element that is found
+    zval **result;
+
+    // numeric keys are stored by their index
+    if (key.isNumeric()) return zend_hash_index_find(table, key.hash(), (void **)&result) == SUCCESS ? result : nullptr;
+
+    // string keys are found without hashing them again
+    return zend_hash_quick_find(table, key.data(), key.size() + 1, key.hash(), (void **)&result) == SUCCESS ? result : nullptr;
+}
+
+/**
+ *  Add or replace an element in a hash table, the table takes over the
+ *  reference to the value, so the caller should increment its refcount
+ *  @param  table       The hash table
+ *  @param  key         The key to store the value under
+ *  @param  value       The value to store
+ */
+inline void update(HashTable *table, const Key &key, zval *value)
+{
+    // numeric keys are stored by their index
+    if (key.isNumeric()) zend_hash_index_update(table, key.hash(), (void *)&value, sizeof(zval *), nullptr);
+
+    // string keys are stored without hashing them again
+    else zend_hash_quick_update(table, key.data(), key.size() + 1, key.hash(), (void *)&value, sizeof(zval *), nullptr);
+}
+
+/**
+ *  Remove an element from a hash table
+ *  @param  table       The hash table
+ *  @param  key         The key to remove
+ */
+inline void remove(HashTable *table, const Key &key)
+{
+    // numeric keys are stored by their index
+    if (key.isNumeric()) zend_hash_index_del(table, key.hash());
+
+    // string keys are removed without hashing them again
+    else zend_hash_quick_del(table, key.data(), key.size() + 1, key.hash());
+}
+
+/**
+ *  End of namespace
+ */
+}
@@ -0,0 +1,612 @@
+/**
+ *  LocalValue.cpp
+ *
+ *  Implementation for the LocalValue class, a scalar value that keeps its
+ *  zval inline instead of allocating it on the heap
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2019 Copernica BV
+ */
+#include "includes.h"
+#include "conversion.h"
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Access to the inline zval
+ *  @return zval
+ */
+zval *LocalValue::val()
+{
+    // the storage must be big enough to hold a zval
+    static_assert(sizeof(zval) <= sizeof(_storage), "storage for inline zval is too small");
+
+    // the storage holds the zval
+    return reinterpret_cast<zval *>(_storage);
+}
+
+/**
+ *  Access to the inline zval
+ *  @return zval
+ */
+const zval *LocalValue::val() const
+{
+    // the storage holds the zval
+    return reinterpret_cast<const zval *>(_storage);
+}
+
+/**
+ *  Constructor (value = NULL)
+ */
+LocalValue::LocalValue()
+{
+    // initialize the inline zval
+    INIT_ZVAL(*val());
+}
+
+/**
+ *  Constructor for null ptr
+ *  @param  value
+ */
+LocalValue::LocalValue(std::nullptr_t value) : LocalValue() {}
+
+/**
+ *  Constructor based on integer value
+ *  @param  value
+ */
+LocalValue::LocalValue(int16_t value) : LocalValue()
+{
+    // store the integer
+    ZVAL_LONG(val(), value);
+}
+
+/**
+ *  Constructor based on integer value
+ *  @param  value
+ */
+LocalValue::LocalValue(int32_t value) : LocalValue()
+{
+    // store the integer
+    ZVAL_LONG(val(), value);
+}
+
+/**
+ *  Constructor based on int64_t value
+ *  @param  value
+ */
+LocalValue::LocalValue(int64_t value) : LocalValue()
+{
+    // store the integer
+    ZVAL_LONG(val(), value);
+}
+
+/**
+ *  Constructor based on boolean value
+ *  @param  value
+ */
+LocalValue::LocalValue(bool value) : LocalValue()
+{
+    // store the boolean
+    ZVAL_BOOL(val(), value);
+}
+
+/**
+ *  Constructor based on single character
+ *  @param  value
+ */
+LocalValue::LocalValue(char value) : LocalValue()
+{
+    // store the string
+    ZVAL_STRINGL(val(), &value, 1, 1);
+}
+
+/**
+ *  Constructor based on string value
+ *  @param  value
+ */
+LocalValue::LocalValue(const std::string &value) : LocalValue()
+{
+    // store the string
+    ZVAL_STRINGL(val(), value.c_str(), value.size(), 1);
+}
+
+/**
+ *  Constructor based on a byte array
+ *  @param  value
+ *  @param  size
+ */
+LocalValue::LocalValue(const char *value, int size) : LocalValue()
+{
+    // nothing to store if there is no value (we remain null)
+    if (!value) return;
+
+    // store the string
+    ZVAL_STRINGL(val(), value, size < 0 ? ::strlen(value) : size, 1);
+}
+
+/**
+ *  Constructor based on decimal value
+ *  @param  value
+ */
+LocalValue::LocalValue(double value) : LocalValue()
+{
+    // store the double
+    ZVAL_DOUBLE(val(), value);
+}
+
+/**
+ *  Copy constructor
+ *  @param  that
+ */
+LocalValue::LocalValue(const LocalValue &that)
+{
+    // copy the inline zval, strings have to be duplicated
+    INIT_PZVAL_COPY(val(), that.val());
+    zval_copy_ctor(val());
+}
+
+/**
+ *  Move constructor
+ *  @param  that
+ */
+LocalValue::LocalValue(LocalValue &&that) _NOEXCEPT
+{
+    // take over the inline zval (including a possible string buffer)
+    INIT_PZVAL_COPY(val(), that.val());
+
+    // the other object no longer owns the buffer
+    ZVAL_NULL(that.val());
+}
+
+/**
+ *  Destructor
+ */
+LocalValue::~LocalValue()
+{
+    // clean up the zval contents, this only does something for strings
+    zval_dtor(val());
+}
+
+/**
+ *  Assignment operator
+ *  @param  value
+ *  @return LocalValue
+ */
+LocalValue &LocalValue::operator=(const LocalValue &value)
+{
+    // skip self assignment
+    if (this == &value) return *this;
+
+    // deallocate current contents
+    zval_dtor(val());
+
+    // copy the inline zval, strings have to be duplicated
+    ZVAL_COPY_VALUE(val(), value.val());
+    zval_copy_ctor(val());
+
+    // done
+    return *this;
+}
+
+/**
+ *  Move assignment operator
+ *  @param  value
+ *  @return LocalValue
+ */
+LocalValue &LocalValue::operator=(LocalValue &&value) _NOEXCEPT
+{
+    // skip self assignment
+    if (this == &value) return *this;
+
+    // deallocate current contents
+    zval_dtor(val());
+
+    // take over the inline zval, the other object no longer owns it
+    ZVAL_COPY_VALUE(val(), value.val());
+    ZVAL_NULL(value.val());
+
+    // done
+    return *this;
+}
+
+/**
+ *  Assignment operator
+ *  @param  value
+ *  @return LocalValue
+ */
+LocalValue &LocalValue::operator=(std::nullptr_t value)
+{
+    // deallocate current contents
+    zval_dtor(val());
+
+    // change to null value
+    ZVAL_NULL(val());
+
+    // done
+    return *this;
+}
+
+/**
+ *  Assignment operator
+ *  @param  value
+ *  @return LocalValue
+ */
+LocalValue &LocalValue::operator=(int16_t value)
+{
+    // deallocate current contents
+    zval_dtor(val());
+
+    // set new value
+    ZVAL_LONG(val(), value);
+
+    // done
+    return *this;
+}
+
+/**
+ *  Assignment operator
+ *  @param  value
+ *  @return LocalValue
+ */
+LocalValue &LocalValue::operator=(int32_t value)
+{
+    // deallocate current contents
+    zval_dtor(val());
+
+    // set new value
+    ZVAL_LONG(val(), value);
+
+    // done
+    return *this;
+}
+
+/**
+ *  Assignment operator
+ *  @param  value
+ *  @return LocalValue
+ */
+LocalValue &LocalValue::operator=(int64_t value)
+{
+    // deallocate current contents
+    zval_dtor(val());
+
+    // set new value
+    ZVAL_LONG(val(), value);
+
+    // done
+    return *this;
+}
+
+/**
+ *  Assignment operator
+ *  @param  value
+ *  @return LocalValue
+ */
+LocalValue &LocalValue::operator=(bool value)
+{
+    // deallocate current contents
+    zval_dtor(val());
+
+    // set new value
+    ZVAL_BOOL(val(), value);
+
+    // done
+    return *this;
+}
+
+/**
+ *  Assignment operator
+ *  @param  value
+ *  @return LocalValue
+ */
+LocalValue &LocalValue::operator=(char value)
+{
+    // deallocate current contents
+    zval_dtor(val());
+
+    // set new value
+    ZVAL_STRINGL(val(), &value, 1, 1);
+
+    // done
+    return *this;
+}
+
+/**
+ *  Assignment operator
+ *  @param  value
+ *  @return LocalValue
+ */
+LocalValue &LocalValue::operator=(const std::string &value)
+{
+    // deallocate current contents
+    zval_dtor(val());
+
+    // set new value
+    ZVAL_STRINGL(val(), value.c_str(), value.size(), 1);
+
+    // done
+    return *this;
+}
+
+/**
+ *  Assignment operator
+ *  @param  value
+ *  @return LocalValue
+ */
+LocalValue &LocalValue::operator=(const char *value)
+{
+    // deallocate current contents
+    zval_dtor(val());
+
+    // set new value
+    if (value) ZVAL_STRINGL(val(), value, ::strlen(value), 1);
+    else ZVAL_NULL(val());
+
+    // done
+    return *this;
+}
+
+/**
+ *  Assignment operator
+ *  @param  value
+ *  @return LocalValue
+ */
+LocalValue &LocalValue::operator=(double value)
+{
+    // deallocate current contents
+    zval_dtor(val());
+
+    // set new value
+    ZVAL_DOUBLE(val(), value);
+
+    // done
+    return *this;
+}
+
+/**
+ *  Helper function to apply one of the zend arithmetic functions to
+ *  the inline zval, with an operand that is also stored on the stack
+ *  @param  function    The zend function to call (add_function, sub_function, etc)
+ *  @param  result      The zval to update
+ *  @param  operand     The operand
+ */
+static void apply(int (*function)(zval *, zval *, zval * TSRMLS_DC), zval *result, zval *operand)
+{
+    // we need the tsrm_ls variable
+    TSRMLS_FETCH();
+
+    // the zend functions support using the same zval for result and operand,
+    // this is what they do for compound assignment operators too
+    function(result, result, operand TSRMLS_CC);
+}
+
+/**
+ *  Arithmetic operators
+ *  @param  value
+ *  @return LocalValue
+ */
+LocalValue &LocalValue::operator+=(int64_t value)
+{
+    // construct the operand on the stack
+    zval operand;
+    INIT_ZVAL(operand);
+    ZVAL_LONG(&operand, value);
+
+    // run the operation
+    apply(add_function, val(), &operand);
+
+    // done
+    return *this;
+}
+
+/**
+ *  Arithmetic operators
+ *  @param  value
+ *  @return LocalValue
+ */
+LocalValue &LocalValue::operator+=(double value)
+{
+    // construct the operand on the stack
+    zval operand;
+    INIT_ZVAL(operand);
+    ZVAL_DOUBLE(&operand, value);
+
+    // run the operation
+    apply(add_function, val(), &operand);
+
+    // done
+    return *this;
+}
+
+/**
+ *  Arithmetic operators
+ *  @param  value
+ *  @return LocalValue
+ */
+LocalValue &LocalValue::operator-=(int64_t value)
+{
+    // construct the operand on the stack
+    zval operand;
+    INIT_ZVAL(operand);
+    ZVAL_LONG(&operand, value);
+
+    // run the operation
+    apply(sub_function, val(), &operand);
+
+    // done
+    return *this;
+}
+
+/**
+ *  Arithmetic operators
+ *  @param  value
+ *  @return LocalValue
+ */
+LocalValue &LocalValue::operator-=(double value)
+{
+    // construct the operand on the stack
+    zval operand;
+    INIT_ZVAL(operand);
+    ZVAL_DOUBLE(&operand, value);
+
+    // run the operation
+    apply(sub_function, val(), &operand);
+
+    // done
+    return *this;
+}
+
+/**
+ *  Arithmetic operators
+ *  @param  value
+ *  @return LocalValue
+ */
+LocalValue &LocalValue::operator*=(int64_t value)
+{
+    // construct the operand on the stack
+    zval operand;
+    INIT_ZVAL(operand);
+    ZVAL_LONG(&operand, value);
+
+    // run the operation
+    apply(mul_function, val(), &operand);
+
+    // done
+    return *this;
+}
+
+/**
+ *  Arithmetic operators
+ *  @param  value
+ *  @return LocalValue
+ */
+LocalValue &LocalValue::operator*=(double value)
+{
+    // construct the operand on the stack
+    zval operand;
+    INIT_ZVAL(operand);
+    ZVAL_DOUBLE(&operand, value);
+
+    // run the operation
+    apply(mul_function, val(), &operand);
+
+    // done
+    return *this;
+}
+
+/**
+ *  Arithmetic operators
+ *  @param  value
+ *  @return LocalValue
+ */
+LocalValue &LocalValue::operator/=(int64_t value)
+{
+    // construct the operand on the stack
+    zval operand;
+    INIT_ZVAL(operand);
+    ZVAL_LONG(&operand, value);
+
+    // run the operation
+    apply(div_function, val(), &operand);
+
+    // done
+    return *this;
+}
+
+/**
+ *  Arithmetic operators
+ *  @param  value
+ *  @return LocalValue
+ */
+LocalValue &LocalValue::operator/=(double value)
+{
+    // construct the operand on the stack
+    zval operand;
+    INIT_ZVAL(operand);
+    ZVAL_DOUBLE(&operand, value);
+
+    // run the operation
+    apply(div_function, val(), &operand);
+
+    // done
+    return *this;
+}
+
+/**
+ *  The type of the value
+ *  @return Type
+ */
+Type LocalValue::type() const
+{
+    // return regular type
+    return (Type)Z_TYPE_P(val());
+}
+
+/**
+ *  Retrieve the value as number
+ *  @return int64_t
+ */
+int64_t LocalValue::numericValue() const
+{
+    // already a number
+    if (isNumeric()) return Z_LVAL_P(val());
+
+    // convert the inline zval (this does not modify it)
+    return Conversion::numericValue(const_cast<zval *>(val()));
+}
+
+/**
+ *  Retrieve the value as boolean
+ *  @return bool
+ */
+bool LocalValue::boolValue() const
+{
+    // already a bool
+    if (isBool()) return Z_BVAL_P(val());
+
+    // convert the inline zval (this does not modify it)
+    return Conversion::boolValue(const_cast<zval *>(val()));
+}
+
+/**
+ *  Retrieve the value as a string
+ *  @return string
+ */
+std::string LocalValue::stringValue() const
+{
+    // already a string
+    if (isString()) return std::string(Z_STRVAL_P(val()), Z_STRLEN_P(val()));
+
+    // make a copy on the stack, and convert that one
+    zval copy;
+    INIT_PZVAL_COPY(&copy, val());
+    convert_to_string(&copy);
+
+    // copy the string, and clean up the converted copy
+    std::string result(Z_STRVAL(copy), Z_STRLEN(copy));
+    zval_dtor(&copy);
+
+    // done
+    return result;
+}
+
+/**
+ *  Retrieve the value as decimal
+ *  @return double
+ */
+double LocalValue::floatValue() const
+{
+    // already a double
+    if (isFloat()) return Z_DVAL_P(val());
+
+    // convert the inline zval (this does not modify it)
+    return Conversion::floatValue(const_cast<zval *>(val()));
+}
+
+/**
+ *  End of namespace
+ */
+}
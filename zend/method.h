@@ -37,26 +37,26 @@ public:
      *  @param  flags           Access flags
      *  @param  args            Argument description
      */
-    Method(const char *name, const method_callback_0 &callback, int flags, const Arguments &args) : Callable(name, args), _type(0),    _flags(flags) { _callback.m0  = callback; }
-    Method(const char *name, const method_callback_1 &callback, int flags, const Arguments &args) : Callable(name, args), _type(1),    _flags(flags) { _callback.m1  = callback; }
-    Method(const char *name, const method_callback_2 &callback, int flags, const Arguments &args) : Callable(name, args), _type(2),    _flags(flags) { _callback.m2  = callback; }
-    Method(const char *name, const method_callback_3 &callback, int flags, const Arguments &args) : Callable(name, args), _type(3),    _flags(flags) { _callback.m3  = callback; }
-    Method(const char *name, const method_callback_4 &callback, int flags, const Arguments &args) : Callable(name, args), _type(4),    _flags(flags) { _callback.m4  = callback; }
-    Method(const char *name, const method_callback_5 &callback, int flags, const Arguments &args) : Callable(name, args), _type(5),    _flags(flags) { _callback.m5  = callback; }
-    Method(const char *name, const method_callback_6 &callback, int flags, const Arguments &args) : Callable(name, args), _type(6),    _flags(flags) { _callback.m6  = callback; }
-    Method(const char *name, const method_callback_7 &callback, int flags, const Arguments &args) : Callable(name, args), _type(7),    _flags(flags) { _callback.m7  = callback; }
-    Method(const char *name, const native_callback_0 &callback, int flags, const Arguments &args) : Callable(name, args), _type(8),    _flags(flags) { _callback.m8  = callback; }
-    Method(const char *name, const native_callback_1 &callback, int flags, const Arguments &args) : Callable(name, args), _type(9),    _flags(flags) { _callback.m9  = callback; }
-    Method(const char *name, const native_callback_2 &callback, int flags, const Arguments &args) : Callable(name, args), _type(10),   _flags(flags) { _callback.m10 = callback; }
-    Method(const char *name, const native_callback_3 &callback, int flags, const Arguments &args) : Callable(name, args), _type(11),   _flags(flags) { _callback.m11 = callback; }
-    Method(const char *name,                                    int flags, const Arguments &args) : Callable(name, args), _type(9999), _flags(flags) { _callback.m0 = nullptr;  }
+    Method(const char *name, const method_callback_0 &callback, int flags, const Arguments &args) : Callable(name, args), _flags(flags) { _callback.m0 = callback; _invoker = &invoke0; }
+    Method(const char *name, const method_callback_1 &callback, int flags, const Arguments &args) : Callable(name, args), _flags(flags) { _callback.m1 = callback; _invoker = &invoke1; }
+    Method(const char *name, const method_callback_2 &callback, int flags, const Arguments &args) : Callable(name, args), _flags(flags) { _callback.m2 = callback; _invoker = &invoke2; }
+    Method(const char *name, const method_callback_3 &callback, int flags, const Arguments &args) : Callable(name, args), _flags(flags) { _callback.m3 = callback; _invoker = &invoke3; }
+    Method(const char *name, const method_callback_4 &callback, int flags, const Arguments &args) : Callable(name, args), _flags(flags) { _callback.m4 = callback; _invoker = &invoke4; }
+    Method(const char *name, const method_callback_5 &callback, int flags, const Arguments &args) : Callable(name, args), _flags(flags) { _callback.m5 = callback; _invoker = &invoke5; }
+    Method(const char *name, const method_callback_6 &callback, int flags, const Arguments &args) : Callable(name, args), _flags(flags) { _callback.m6 = callback; _invoker = &invoke6; }
+    Method(const char *name, const method_callback_7 &callback, int flags, const Arguments &args) : Callable(name, args), _flags(flags) { _callback.m7 = callback; _invoker = &invoke7; }
+    Method(const char *name, const native_callback_0 &callback, int flags, const Arguments &args) : Callable(name, args), _flags(flags) { _callback.m8 = callback; _invoker = &invoke8; }
+    Method(const char *name, const native_callback_1 &callback, int flags, const Arguments &args) : Callable(name, args), _flags(flags) { _callback.m9 = callback; _invoker = &invoke9; }
+    Method(const char *name, const native_callback_2 &callback, int flags, const Arguments &args) : Callable(name, args), _flags(flags) { _callback.m10 = callback; _invoker = &invoke10; }
+    Method(const char *name, const native_callback_3 &callback, int flags, const Arguments &args) : Callable(name, args), _flags(flags) { _callback.m11 = callback; _invoker = &invoke11; }
+    Method(const char *name,                                    int flags, const Arguments &args) : Callable(name, args), _flags(flags) { _callback.m0 = nullptr; _invoker = &abstract; }
 
     /**
      *  Copy and move constructors
      *  @param  that
      */
-    Method(const Method &that) : Callable(that), _type(that._type), _flags(that._flags), _callback(that._callback) {}
-    Method(Method &&that) : Callable(std::move(that)), _type(that._type), _flags(that._flags), _callback(that._callback) {}
+    Method(const Method &that) : Callable(that), _flags(that._flags), _callback(that._callback) {}
+    Method(Method &&that) : Callable(std::move(that)), _flags(that._flags), _callback(that._callback) {}
 
     /**
      *  Destructor
@@ -80,41 +80,26 @@ public:
         Callable::initialize(entry, classname.c_str(), _flags);
     }
 
-    /**
-     *  Invoke the method
-     *  @param  parameters
-     *  @return Value
-     */
-    virtual Value invoke(Parameters &parameters) override
-    {
-        // the object to call a method on
-        Base *base = parameters.object();
-        
-        // find out which method to call, and call it
-        switch (_type) {
-        case 0:     (base->*_callback.m0)(); return Value();
-        case 1:     (base->*_callback.m1)(parameters); return Value();
-        case 2:     return (base->*_callback.m2)();
-        case 3:     return (base->*_callback.m3)(parameters);
-        case 4:     (base->*_callback.m4)(); return Value();
-        case 5:     (base->*_callback.m5)(parameters); return Value();
-        case 6:     return (base->*_callback.m6)();
-        case 7:     return (base->*_callback.m7)(parameters);
-        case 8:     _callback.m8(); return Value();
-        case 9:     _callback.m9(parameters); return Value();
-        case 10:    return _callback.m10();
-        case 11:    return _callback.m11(parameters);
-        default:    return Value();
-        }
-    }
-
-
 private:
     /**
-     *  Callback type
-     *  @var int
+     *  Functions that call the method, one for each signature
+     *  @param  callable    The method object
+     *  @param  params      The parameters that were passed
+     *  @return Value       Return value
      */
-    int _type;
+    static Value invoke0(Callable *callable, Parameters &params)  { (params.object()->*static_cast<Method*>(callable)->_callback.m0)(); return Value(); }
+    static Value invoke1(Callable *callable, Parameters &params)  { (params.object()->*static_cast<Method*>(callable)->_callback.m1)(params); return Value(); }
+    static Value invoke2(Callable *callable, Parameters &params)  { return (params.object()->*static_cast<Method*>(callable)->_callback.m2)(); }
+    static Value invoke3(Callable *callable, Parameters &params)  { return (params.object()->*static_cast<Method*>(callable)->_callback.m3)(params); }
+    static Value invoke4(Callable *callable, Parameters &params)  { (params.object()->*static_cast<Method*>(callable)->_callback.m4)(); return Value(); }
+    static Value invoke5(Callable *callable, Parameters &params)  { (params.object()->*static_cast<Method*>(callable)->_callback.m5)(params); return Value(); }
+    static Value invoke6(Callable *callable, Parameters &params)  { return (params.object()->*static_cast<Method*>(callable)->_callback.m6)(); }
+    static Value invoke7(Callable *callable, Parameters &params)  { return (params.object()->*static_cast<Method*>(callable)->_callback.m7)(params); }
+    static Value invoke8(Callable *callable, Parameters &params)  { static_cast<Method*>(callable)->_callback.m8(); return Value(); }
+    static Value invoke9(Callable *callable, Parameters &params)  { static_cast<Method*>(callable)->_callback.m9(params); return Value(); }
+    static Value invoke10(Callable *callable, Parameters &params) { return static_cast<Method*>(callable)->_callback.m10(); }
+    static Value invoke11(Callable *callable, Parameters &params) { return static_cast<Method*>(callable)->_callback.m11(params); }
+    static Value abstract(Callable *callable, Parameters &params) { return Value(); }
 
     /**
      *  Access flags (protected, public, abstract, final, private, etc)
@@ -0,0 +1,107 @@
+/**
+ *  MethodCache.cpp
+ *
+ *  Implementation of the MethodCache class
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2019 Copernica BV
+ */
+#include "includes.h"
+#include "methodcache.h"
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Number of slots in the cache (must be a power of two)
+ */
+static const size_t capacity = 256;
+
+/**
+ *  The slots (in thread safe mode every thread has its own cache)
+ */
+#ifdef ZTS
+static thread_local MethodCache::Entry entries[capacity];
+#else
+static MethodCache::Entry entries[capacity];
+#endif
+
+/**
+ *  Helper function to find the slot for a method
+ *  @param  ce          The class entry
+ *  @param  hash        Hash of the name
+ *  @return Entry
+ */
+static MethodCache::Entry &slot(zend_class_entry *ce, unsigned long hash)
+{
+    // mix the address of the class entry into the hash (the lowest bits
+    // of the address are always zero because of the alignment)
+    return entries[(hash ^ ((uintptr_t)ce >> 4)) & (capacity - 1)];
+}
+
+/**
+ *  Find a method in the cache
+ *  @param  ce          The class entry
+ *  @param  name        Name of the method
+ *  @param  size        Size of the name
+ *  @return Entry
+ */
+const MethodCache::Entry *MethodCache::find(zend_class_entry *ce, const char *name, size_t size)
+{
+    // hash the name
+    unsigned long hash = zend_inline_hash_func(name, size);
+
+    // the slot where the method should be
+    auto &entry = slot(ce, hash);
+
+    // check if the slot holds this method
+    if (entry.ce != ce || entry.hash != hash || entry.name.size() != size) return nullptr;
+    if (memcmp(entry.name.data(), name, size) != 0) return nullptr;
+
+    // found it
+    return &entry;
+}
+
+/**
+ *  Store a method in the cache
+ *  @param  ce          The class entry
+ *  @param  name        Name of the method
+ *  @param  size        Size of the name
+ *  @param  function    The method from the function table
+ *  @param  callable    Is the method callable?
+ *  @return Entry
+ */
+const MethodCache::Entry *MethodCache::store(zend_class_entry *ce, const char *name, size_t size, zend_function *function, bool callable)
+{
+    // hash the name
+    unsigned long hash = zend_inline_hash_func(name, size);
+
+    // the slot to use
+    auto &entry = slot(ce, hash);
+
+    // fill the slot (assigning the name reuses the buffer of the previous entry)
+    entry.ce = ce;
+    entry.hash = hash;
+    entry.name.assign(name, size);
+    entry.function = function;
+    entry.callable = callable;
+
+    // done
+    return &entry;
+}
+
+/**
+ *  Remove all entries from the cache
+ */
+void MethodCache::clear()
+{
+    // forget the class entries, they may be destructed after this request
+    for (auto &entry : entries) entry.ce = nullptr;
+}
+
+/**
+ *  End of namespace
+ */
+}
@@ -0,0 +1,99 @@
+/**
+ *  MethodCache.h
+ *
+ *  Small cache that remembers which methods exist in a class. Looking up
+ *  a method normally requires a lowercase copy of the name and a probe in
+ *  the function table of the class. The cache is keyed by the class entry
+ *  and the name exactly as it was passed, so that repeated lookups do not
+ *  allocate anything.
+ *
+ *  Class entries of user space classes are destructed at the end of the
+ *  request, so the cache must be cleared when a request ends.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2019 Copernica BV
+ */
+
+/**
+ *  Include guard
+ */
+#pragma once
+
+/**
+ *  Begin of namespace
+ */
+namespace Php {
+
+/**
+ *  Class definition
+ */
+class MethodCache
+{
+public:
+    /**
+     *  Structure holding one cached method
+     */
+    struct Entry
+    {
+        /**
+         *  The class entry
+         *  @var zend_class_entry
+         */
+        zend_class_entry *ce = nullptr;
+
+        /**
+         *  Hash of the name
+         *  @var unsigned long
+         */
+        unsigned long hash = 0;
+
+        /**
+         *  The name of the method, as it was passed to the lookup
+         *  @var std::string
+         */
+        std::string name;
+
+        /**
+         *  The method from the function table (nullptr if the method
+         *  is not in the function table)
+         *  @var zend_function
+         */
+        zend_function *function = nullptr;
+
+        /**
+         *  Is the method callable?
+         *  @var bool
+         */
+        bool callable = false;
+    };
+
+    /**
+     *  Find a method in the cache
+     *  @param  ce          The class entry
+     *  @param  name        Name of the method
+     *  @param  size        Size of the name
+     *  @return Entry       The entry, or nullptr when the method is not in the cache
+     */
+    static const Entry *find(zend_class_entry *ce, const char *name, size_t size);
+
+    /**
+     *  Store a method in the cache (this replaces the entry that occupied the same slot)
+     *  @param  ce          The class entry
+     *  @param  name        Name of the method
+     *  @param  size        Size of the name
+     *  @param  function    The method from the function table
+     *  @param  callable    Is the method callable?
+     *  @return Entry       The new entry
+     */
+    static const Entry *store(zend_class_entry *ce, const char *name, size_t size, zend_function *function, bool callable);
+
+    /**
+     *  Remove all entries from the cache
+     */
+    static void clear();
+};
+
+/**
+ *  End of namespace
+ */
+}
@@ -32,44 +32,28 @@ public:
      *  @param  name            Function name
      *  @param  function        The native C function
      */
-    NativeFunction(const char *name, const native_callback_0 &function, const Arguments &arguments = {}) : Callable(name, arguments), _type(0) { _function.f0 = function; }
-    NativeFunction(const char *name, const native_callback_1 &function, const Arguments &arguments = {}) : Callable(name, arguments), _type(1) { _function.f1 = function; }
-    NativeFunction(const char *name, const native_callback_2 &function, const Arguments &arguments = {}) : Callable(name, arguments), _type(2) { _function.f2 = function; }
-    NativeFunction(const char *name, const native_callback_3 &function, const Arguments &arguments = {}) : Callable(name, arguments), _type(3) { _function.f3 = function; }
+    NativeFunction(const char *name, const native_callback_0 &function, const Arguments &arguments = {}) : Callable(name, arguments) { _function.f0 = function; _invoker = &invoke0; }
+    NativeFunction(const char *name, const native_callback_1 &function, const Arguments &arguments = {}) : Callable(name, arguments) { _function.f1 = function; _invoker = &invoke1; }
+    NativeFunction(const char *name, const native_callback_2 &function, const Arguments &arguments = {}) : Callable(name, arguments) { _function.f2 = function; _invoker = &invoke2; }
+    NativeFunction(const char *name, const native_callback_3 &function, const Arguments &arguments = {}) : Callable(name, arguments) { _function.f3 = function; _invoker = &invoke3; }
 
     /**
      *  Copy constructor
      *  @param  that
      */
-    NativeFunction(const NativeFunction &that) : Callable(that), _function(that._function), _type(that._type) {}
+    NativeFunction(const NativeFunction &that) : Callable(that), _function(that._function) {}
 
     /**
      *  Move constructor
      *  @param  that
      */
-    NativeFunction(NativeFunction &&that) : Callable(std::move(that)), _function(that._function), _type(that._type) {}
+    NativeFunction(NativeFunction &&that) : Callable(std::move(that)), _function(that._function) {}
 
     /**
      *  Destructor
      */
     virtual ~NativeFunction() {}
 
-    /**
-     *  Method that gets called every time the function is executed
-     *  @param  params      The parameters that were passed
-     *  @return Variable    Return value
-     */
-    virtual Value invoke(Parameters &params) override
-    {
-        switch (_type) {
-        case 0:     _function.f0(); return Value();
-        case 1:     _function.f1(params); return Value();
-        case 2:     return _function.f2();
-        case 3:     return _function.f3(params);
-        default:    return Value();
-        }
-    }
-
     /**
      *  Fill a function entry
      *  @param  prefix      Active namespace prefix
@@ -78,13 +62,24 @@ public:
     void initialize(const std::string &prefix, zend_function_entry *entry)
     {
         // if there is a namespace prefix, we should adjust the name
-        if (prefix.size()) _ptr = HiddenPointer<Callable>(this, prefix+"\\"+(const char *)_ptr);
+        if (prefix.size()) _name = prefix + "\\" + _name;
         
         // call base initialize
         Callable::initialize(entry);
     }
 
 private:
+    /**
+     *  Functions that call the native function, one for each signature
+     *  @param  callable    The function object
+     *  @param  params      The parameters that were passed
+     *  @return Value       Return value
+     */
+    static Value invoke0(Callable *callable, Parameters &params) { static_cast<NativeFunction*>(callable)->_function.f0(); return Value(); }
+    static Value invoke1(Callable *callable, Parameters &params) { static_cast<NativeFunction*>(callable)->_function.f1(params); return Value(); }
+    static Value invoke2(Callable *callable, Parameters &params) { return static_cast<NativeFunction*>(callable)->_function.f2(); }
+    static Value invoke3(Callable *callable, Parameters &params) { return static_cast<NativeFunction*>(callable)->_function.f3(params); }
+
     /**
      *  Union of supported callbacks
      *  One of the callbacks will be set 
@@ -95,12 +90,6 @@ private:
         native_callback_2 f2;
         native_callback_3 f3;
     } _function;
-    
-    /**
-     *  The callback that is set
-     *  @var integer
-     */
-    int _type;
 };
 
 /**
@@ -43,7 +43,7 @@ Object::Object(const char *name, Base *base) : Value()
         // member in the base object), this is a self-destructing object that
         // will be destructed when the last reference to it has been removed,
         // we already set the reference to zero
-        new ObjectImpl(entry, base, 0 TSRMLS_CC);
+        ObjectImpl::create(entry, base, 0 TSRMLS_CC);
 
         // now we can store it
         operator=(Value(base));
@@ -76,7 +76,7 @@ Object::Object(zend_class_entry *entry, Base *base) : Value()
         // member in the base object), this is a self-destructing object that
         // will be destructed when the last reference to it has been removed,
         // we already set the reference to zero
-        new ObjectImpl(entry, base, 0 TSRMLS_CC);
+        ObjectImpl::create(entry, base, 0 TSRMLS_CC);
 
         // now we can store it
         operator=(Value(base));
@@ -15,32 +15,22 @@ namespace Php {
 
 /**
  *  Class definition
+ *
+ *  The object is allocated in one block of memory that starts with the
+ *  zend_object (so that a pointer to the zend_object can be casted to a
+ *  pointer to this object), followed by the bookkeeping members, followed
+ *  by the C++ object itself. The Zend engine deallocates the block when
+ *  the object is destructed.
  */
 class ObjectImpl
 {
 private:
     /**
-     *  Structure with a first element which is a zend_object, so that
-     *  it can be casted to a zend_object
-     *  @var    MixedObject
+     *  The PHP object, this must be the first member, so that casting
+     *  the zend_object to an ObjectImpl results in a valid pointer
+     *  @var    zend_object
      */
-    struct MixedObject
-    {
-        /**
-         *  The actual object is the first member, so that casting
-         *  the MixedObject to a zend_object will also result in a valid pointer
-         *  @var    zend_object
-         */
-        zend_object php;
-
-        /**
-         *  Pointer to ourselves
-         *  @var    ObjectImpl
-         */
-        ObjectImpl *self;
-
-
-    } *_mixed;
+    zend_object _php;
 
     /**
      *  Pointer to the C++ implementation
@@ -54,31 +44,40 @@ private:
      */
     int _handle;
 
-public:
+    /**
+     *  Is the C++ object stored in the same block of memory?
+     *  @var bool
+     */
+    bool _embedded;
+
+    /**
+     *  The pool to give the memory back to (nullptr if the memory is freed)
+     *  @var ObjectPool
+     */
+    ObjectPool *_pool;
+
     /**
      *  Constructor
      *
-     *  This will create a new object in the Zend engine.
+     *  This will create a new object in the Zend engine. The constructor is
+     *  private because the object must be constructed in memory that was
+     *  allocated with emalloc(), use one of the static methods instead.
      *
      *  @param  entry       Zend class entry
      *  @param  base        C++ object that already exists
+     *  @param  embedded    Is the C++ object stored in the same block of memory?
+     *  @param  pool        Pool that the memory came from
      *  @param  refcount    The initial refcount for the object
      *  @param  tsrm_ls     Optional threading data
      */
-    ObjectImpl(zend_class_entry *entry, Base *base, int refcount TSRMLS_DC)
+    ObjectImpl(zend_class_entry *entry, Base *base, bool embedded, ObjectPool *pool, int refcount TSRMLS_DC) :
+        _object(base), _embedded(embedded), _pool(pool)
     {
-        // allocate a mixed object (for some reason this does not have to be deallocated)
-        _mixed = (MixedObject *)emalloc(sizeof(MixedObject));
-
-        // copy properties to the mixed object
-        _mixed->php.ce = entry;
-        _mixed->self = this;
-
-        // store the c++ object
-        _object = base;
+        // copy properties to the php object
+        _php.ce = entry;
 
         // initialize the object
-        zend_object_std_init(&_mixed->php, entry TSRMLS_CC);
+        zend_object_std_init(&_php, entry TSRMLS_CC);
 
 #if PHP_VERSION_ID < 50399
 
@@ -86,12 +85,12 @@ public:
         zval *tmp;
 
         // initialize the properties, php 5.3 way
-        zend_hash_copy(_mixed->php.properties, &entry->default_properties, (copy_ctor_func_t) zval_property_ctor, &tmp, sizeof(zval*));
+        zend_hash_copy(_php.properties, &entry->default_properties, (copy_ctor_func_t) zval_property_ctor, &tmp, sizeof(zval*));
 
 #else
 
         // version higher than 5.3 have an easier way to initialize
-        object_properties_init(&_mixed->php, entry);
+        object_properties_init(&_php, entry);
 
 #endif
 
@@ -126,12 +125,100 @@ public:
     }
 
     /**
-     *  Destructor
+     *  Allocate a block of memory for the PHP object and a C++ object, and
+     *  let a callback construct the C++ object in it
+     *
+     *  @param  entry       Zend class entry
+     *  @param  meta        The meta class that knows the size of the C++ object
+     *  @param  pool        The memory pool of the class
+     *  @param  callback    Callback that constructs the C++ object in the memory
+     *  @param  tsrm_ls     Optional threading data
+     *  @return ObjectImpl  The new object, or nullptr if the callback failed
+     */
+    template <typename Callback>
+    static ObjectImpl *instantiate(zend_class_entry *entry, const ClassBase *meta, ObjectPool &pool, const Callback &callback TSRMLS_DC)
+    {
+        // the memory alignment of the C++ object
+        size_t alignment = meta->alignment();
+
+        // the memory that is needed for both objects, with room to align the C++ object
+        size_t size = sizeof(ObjectImpl) + alignment - 1 + meta->size();
+
+        // take the memory from the pool if the class uses one
+        char *buffer = (char *)(pool.enabled() ? pool.allocate(size) : emalloc(size));
+
+        // the C++ object is stored right after this object
+        uintptr_t memory = ((uintptr_t)(buffer + sizeof(ObjectImpl)) + alignment - 1) & ~(uintptr_t)(alignment - 1);
+
+        // the C++ object that is going to be constructed
+        Base *base = nullptr;
+
+        // the constructor of the C++ object might throw
+        try
+        {
+            // construct the C++ object
+            base = callback((void *)memory);
+        }
+        catch (...)
+        {
+            // the memory is no longer needed
+            pool.release(buffer);
+            throw;
+        }
+
+        // check if the object could be constructed
+        if (base) return new (buffer) ObjectImpl(entry, base, true, pool.enabled() ? &pool : nullptr, 1 TSRMLS_CC);
+
+        // the memory is no longer needed
+        pool.release(buffer);
+        return nullptr;
+    }
+
+public:
+    /**
+     *  Create a PHP object for a C++ object that already exists
+     *
+     *  @param  entry       Zend class entry
+     *  @param  base        C++ object that already exists
+     *  @param  refcount    The initial refcount for the object
+     *  @param  tsrm_ls     Optional threading data
+     *  @return ObjectImpl
+     */
+    static ObjectImpl *create(zend_class_entry *entry, Base *base, int refcount TSRMLS_DC)
+    {
+        // the memory is deallocated by the zend engine when the object is destructed
+        return new (emalloc(sizeof(ObjectImpl))) ObjectImpl(entry, base, false, nullptr, refcount TSRMLS_CC);
+    }
+
+    /**
+     *  Create a PHP object and construct the C++ object in the same block of memory
+     *
+     *  @param  entry       Zend class entry
+     *  @param  meta        The meta class that can construct the C++ object
+     *  @param  pool        The memory pool of the class
+     *  @param  tsrm_ls     Optional threading data
+     *  @return ObjectImpl  The new object, or nullptr if it could not be constructed
+     */
+    static ObjectImpl *construct(zend_class_entry *entry, const ClassBase *meta, ObjectPool &pool TSRMLS_DC)
+    {
+        // construct the object with the default constructor
+        return instantiate(entry, meta, pool, [meta](void *memory) { return meta->construct(memory); } TSRMLS_CC);
+    }
+
+    /**
+     *  Create a PHP object and construct a copy of a C++ object in the same block of memory
+     *
+     *  @param  entry       Zend class entry
+     *  @param  meta        The meta class that can copy the C++ object
+     *  @param  pool        The memory pool of the class
+     *  @param  orig        The C++ object to copy
+     *  @param  tsrm_ls     Optional threading data
+     *  @return ObjectImpl  The new object, or nullptr if it could not be copied
      */
-    virtual ~ObjectImpl()
+    static ObjectImpl *clone(zend_class_entry *entry, const ClassBase *meta, ObjectPool &pool, Base *orig TSRMLS_DC)
     {
-        // deallocate the cpp object
-        if (_object) delete _object;
+        // construct the object with the copy constructor
+        return instantiate(entry, meta, pool, [meta, orig](void *memory) { return meta->clone(memory, orig); } TSRMLS_CC);
     }
 
     /**
@@ -140,11 +227,16 @@ public:
      */
     void destruct(TSRMLS_D)
     {
-        // pass on to the default destructor
-        zend_objects_free_object_storage(php() TSRMLS_CC);
+        // destruct the properties of the php object
+        zend_object_std_dtor(&_php TSRMLS_CC);
 
-        // destruct the object
-        delete this;
+        // destruct the cpp object, and deallocate it if it was allocated separately
+        if (_embedded) _object->~Base();
+        else delete _object;
+
+        // deallocate the memory of both objects, or give it back to the pool
+        if (_pool) _pool->release(this);
+        else efree(this);
     }
 
     /**
@@ -155,11 +247,8 @@ public:
      */
     static ObjectImpl *find(zval *val TSRMLS_DC)
     {
-        // retrieve the old object, which we are going to copy
-        MixedObject *object = (MixedObject *)zend_object_store_get_object(val TSRMLS_CC);
-
-        // done
-        return object->self;
+        // the zend_object is the first member of the object
+        return (ObjectImpl *)zend_object_store_get_object(val TSRMLS_CC);
     }
 
     /**
@@ -169,11 +258,8 @@ public:
      */
     static ObjectImpl *find(const zend_object *object)
     {
-        // retrieve the old object, which we are going to copy
-        const MixedObject *mixed = (const MixedObject *)object;
-
-        // done
-        return mixed->self;
+        // the zend_object is the first member of the object
+        return (ObjectImpl *)object;
     }
 
     /**
@@ -191,7 +277,7 @@ public:
      */
     zend_object *php() const
     {
-        return &_mixed->php;
+        return const_cast<zend_object *>(&_php);
     }
 
     /**
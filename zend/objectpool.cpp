@@ -0,0 +1,138 @@
+/**
+ *  ObjectPool.cpp
+ *
+ *  Implementation of the pool with the memory of destructed objects
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2019 Copernica BV
+ */
+#include "includes.h"
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  The first of the pools that are enabled
+ *  @var    ObjectPool
+ */
+static ObjectPool *pools = nullptr;
+
+/**
+ *  Destructor
+ */
+ObjectPool::~ObjectPool()
+{
+    // skip if the pool is not in the list
+    if (!_prev && pools != this) return;
+
+    // remove the pool from the list
+    if (_prev) _prev->_next = _next;
+    else pools = _next;
+    if (_next) _next->_prev = _prev;
+}
+
+/**
+ *  Change the max number of blocks in the pool
+ *  @param  limit       Max number of blocks, zero to disable pooling
+ */
+void ObjectPool::limit(size_t limit)
+{
+#ifndef ZTS
+
+    // add the pool to the list when it is enabled for the first time (it
+    // stays in the list when it is disabled later, so that the blocks that
+    // are still in it are freed at the end of the request)
+    if (limit > 0 && !_prev && pools != this)
+    {
+        _next = pools;
+        if (_next) _next->_prev = this;
+        pools = this;
+    }
+
+    // store the limit
+    _limit = limit;
+
+#endif
+}
+
+/**
+ *  Get a block of memory, from the pool if possible
+ *  @param  size        Size of the block (the same for every call)
+ *  @return void*
+ */
+void *ObjectPool::allocate(size_t size)
+{
+    // is there a block that we can reuse?
+    if (!_blocks)
+    {
+        // no, allocate a new block
+        _statistics.misses += 1;
+        return emalloc(size);
+    }
+
+    // take the block from the pool
+    Block *block = _blocks;
+    _blocks = block->next;
+
+    // update the statistics
+    _statistics.hits += 1;
+    _statistics.size -= 1;
+
+    // done
+    return block;
+}
+
+/**
+ *  Give back a block of memory
+ *  @param  memory
+ */
+void ObjectPool::release(void *memory)
+{
+    // free the block if the pool is full
+    if (_statistics.size >= _limit) return efree(memory);
+
+    // add it to the front of the pool
+    Block *block = (Block *)memory;
+    block->next = _blocks;
+    _blocks = block;
+
+    // update the statistics
+    _statistics.returns += 1;
+    _statistics.size += 1;
+}
+
+/**
+ *  Free all blocks in the pool
+ */
+void ObjectPool::clear()
+{
+    // free all blocks
+    while (_blocks)
+    {
+        // take the first block from the pool
+        Block *block = _blocks;
+        _blocks = block->next;
+
+        // the memory is request memory, so it must be freed before the request ends
+        efree(block);
+    }
+
+    // the pool is empty
+    _statistics.size = 0;
+}
+
+/**
+ *  Empty all pools
+ */
+void ObjectPool::clearAll()
+{
+    // empty all pools
+    for (ObjectPool *pool = pools; pool; pool = pool->_next) pool->clear();
+}
+
+/**
+ *  End of namespace
+ */
+}
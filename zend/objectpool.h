@@ -0,0 +1,125 @@
+/**
+ *  ObjectPool.h
+ *
+ *  Pool with the memory of destructed objects of a class, that is reused
+ *  when new objects of that class are created. Pooling is only enabled for
+ *  classes that ask for it (see Class::pool()).
+ *
+ *  The memory in the pool is request memory (allocated with emalloc()), so
+ *  all pools are emptied when the request ends. The pools are not used in
+ *  thread safe mode, because the memory of one thread can not be given to
+ *  another thread.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2019 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Class definition
+ */
+class ObjectPool
+{
+private:
+    /**
+     *  Structure that is stored in the memory that is in the pool
+     */
+    struct Block
+    {
+        // the next block in the pool
+        Block *next;
+    };
+
+    /**
+     *  The blocks of memory in the pool
+     *  @var    Block
+     */
+    Block *_blocks = nullptr;
+
+    /**
+     *  Max number of blocks in the pool (zero if pooling is disabled)
+     *  @var    size_t
+     */
+    size_t _limit = 0;
+
+    /**
+     *  The statistics
+     *  @var    PoolStatistics
+     */
+    PoolStatistics _statistics;
+
+    /**
+     *  The pools are linked, so that all pools can be emptied at the end
+     *  of the request
+     *  @var    ObjectPool
+     */
+    ObjectPool *_prev = nullptr;
+    ObjectPool *_next = nullptr;
+
+public:
+    /**
+     *  Constructor
+     */
+    ObjectPool() = default;
+
+    /**
+     *  No copying
+     *  @param  that
+     */
+    ObjectPool(const ObjectPool &that) = delete;
+
+    /**
+     *  Destructor
+     */
+    ~ObjectPool();
+
+    /**
+     *  Change the max number of blocks in the pool
+     *  @param  limit       Max number of blocks, zero to disable pooling
+     */
+    void limit(size_t limit);
+
+    /**
+     *  Is pooling enabled?
+     *  @return bool
+     */
+    bool enabled() const { return _limit > 0; }
+
+    /**
+     *  Get a block of memory, from the pool if possible
+     *  @param  size        Size of the block (the same for every call)
+     *  @return void*
+     */
+    void *allocate(size_t size);
+
+    /**
+     *  Give back a block of memory
+     *  @param  memory
+     */
+    void release(void *memory);
+
+    /**
+     *  Free all blocks in the pool
+     */
+    void clear();
+
+    /**
+     *  The statistics
+     *  @return PoolStatistics
+     */
+    const PoolStatistics &statistics() const { return _statistics; }
+
+    /**
+     *  Empty all pools (called when the request ends)
+     */
+    static void clearAll();
+};
+
+/**
+ *  End of namespace
+ */
+}
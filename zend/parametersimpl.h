@@ -26,7 +26,7 @@ public:
      */
     ParametersImpl(zval *this_ptr, int argc TSRMLS_DC) : Parameters(this_ptr ? ObjectImpl::find(this_ptr TSRMLS_CC)->object() : nullptr)
     {
-        // reserve plenty of space
+        // reserve plenty of space (calls with up to four arguments fit in the inline storage)
         reserve(argc);
         
         // loop through the arguments
@@ -43,7 +43,7 @@ public:
     /**
      *  Do _not_ add a virtual destructor here.
      *
-     *  We are extending a vector, which does not itself
+     *  We are extending a small vector, which does not itself
      *  have a virtual destructor, so destructing through
      *  a pointer to this vector has no effect.
      *
@@ -0,0 +1,67 @@
+/**
+ *  Property.cpp
+ *
+ *  Implementation of the properties that are bound to a data member. These
+ *  are read and written directly, without creating a Value object.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2019 Copernica BV
+ */
+#include "includes.h"
+#include "conversion.h"
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Read the data member into a new zval
+ *  @param  base        Object to read it from
+ *  @return zval
+ */
+zval *Property::read(Base *base) const
+{
+    // the new variable
+    zval *result;
+    MAKE_STD_ZVAL(result);
+
+    // check the type of member
+    switch (_mtype) {
+    case 0:     ZVAL_LONG(result, base->*_member.i); break;
+    case 1:     ZVAL_DOUBLE(result, base->*_member.f); break;
+    case 2:     ZVAL_BOOL(result, base->*_member.b); break;
+    default:    ZVAL_STRINGL(result, (base->*_member.s).data(), (base->*_member.s).size(), 1); break;
+    }
+
+    // the caller becomes the owner
+    Z_DELREF_P(result);
+
+    // done
+    return result;
+}
+
+/**
+ *  Write to the data member
+ *  @param  base        Object to write it to
+ *  @param  value       New value
+ */
+void Property::write(Base *base, zval *value) const
+{
+    // check the type of member
+    switch (_mtype) {
+    case 0:     base->*_member.i = Conversion::numericValue(value); break;
+    case 1:     base->*_member.f = Conversion::floatValue(value); break;
+    case 2:     base->*_member.b = Conversion::boolValue(value); break;
+    default:
+        // strings are copied into the buffer that the member already has
+        if (Z_TYPE_P(value) == IS_STRING) (base->*_member.s).assign(Z_STRVAL_P(value), Z_STRLEN_P(value));
+        else base->*_member.s = Conversion::stringValue(value);
+        break;
+    }
+}
+
+/**
+ *  End of namespace
+ */
+}
@@ -48,6 +48,23 @@ private:
      */
     int _stype = 100;
 
+    /**
+     *  The data member that the property is bound to
+     *  @var    member_pointer
+     */
+    union {
+        int_member i;
+        float_member f;
+        bool_member b;
+        string_member s;
+    } _member;
+
+    /**
+     *  Type of data member (100 if the property has a getter and setter)
+     *  @var int
+     */
+    int _mtype = 100;
+
 public:
     /**
      *  Constructor
@@ -114,18 +131,51 @@ public:
         _setter.s1 = setter;
     }
 
+    /**
+     *  Constructors for properties that are bound to a data member
+     *  @param  member
+     */
+    Property(const int_member &member)    : _mtype(0) { _member.i = member; }
+    Property(const float_member &member)  : _mtype(1) { _member.f = member; }
+    Property(const bool_member &member)   : _mtype(2) { _member.b = member; }
+    Property(const string_member &member) : _mtype(3) { _member.s = member; }
+
     /**
      *  Copy constructor
      *  @param  that
      */
     Property(const Property &that) : 
-        _getter(that._getter), _setter(that._setter), _gtype(that._gtype), _stype(that._stype) {}
+        _getter(that._getter), _setter(that._setter), _gtype(that._gtype), _stype(that._stype), _member(that._member), _mtype(that._mtype) {}
     
     /**
      *  Destructor
      */
     virtual ~Property() {}
     
+    /**
+     *  Is the property bound to a data member?
+     *  @return bool
+     */
+    bool member() const
+    {
+        return _mtype != 100;
+    }
+
+    /**
+     *  Read the data member into a new zval, that is owned by the caller
+     *  (the refcount is zero, just like the values returned by the getters)
+     *  @param  base        Object to read it from
+     *  @return zval
+     */
+    zval *read(Base *base) const;
+
+    /**
+     *  Write to the data member
+     *  @param  base        Object to write it to
+     *  @param  value       New value
+     */
+    void write(Base *base, zval *value) const;
+
     /**
      *  Get the property
      *  @param  base        Object to call it on
@@ -0,0 +1,206 @@
+/**
+ *  PropertyIndex.h
+ *
+ *  Index of the properties of a class that are implemented with a getter
+ *  and setter method. The index is a hash table with open addressing, that
+ *  uses the same hash function as the Zend engine. For property names that
+ *  are known at compile time, the engine passes a literal with the hash to
+ *  the property handlers, so that looking up such a property does not even
+ *  require calculating the hash.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2019 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Class definition
+ */
+class PropertyIndex
+{
+private:
+    /**
+     *  Structure of one slot in the table
+     */
+    struct Entry
+    {
+        // hash of the name
+        ulong hash = 0;
+
+        // name of the property
+        std::string name;
+
+        // the property (nullptr for a free slot)
+        std::shared_ptr<Property> property;
+    };
+
+    /**
+     *  The slots, the number of slots is always a power of two
+     *  @var    std::vector
+     */
+    std::vector<Entry> _entries;
+
+    /**
+     *  Number of slots in use
+     *  @var    size_t
+     */
+    size_t _count = 0;
+
+    /**
+     *  Calculate the hash of a name, the same way as the Zend engine does
+     *  (including the terminating null character)
+     *  @param  name
+     *  @param  size
+     *  @return ulong
+     */
+    static ulong hash(const char *name, size_t size)
+    {
+        return zend_hash_func(name, size + 1);
+    }
+
+    /**
+     *  Find the slot for a name
+     *  @param  name
+     *  @param  size
+     *  @param  hash
+     *  @return size_t      Index of the slot holding the name, or of the free slot where it should go
+     */
+    size_t locate(const char *name, size_t size, ulong hash) const
+    {
+        // the mask to turn a hash into an index
+        size_t mask = _entries.size() - 1;
+
+        // probe the slots until the name or a free slot is found
+        for (size_t index = hash & mask; true; index = (index + 1) & mask)
+        {
+            // the slot to check
+            const Entry &entry = _entries[index];
+
+            // a free slot ends the search
+            if (!entry.property) return index;
+
+            // compare the hash first, the name only if the hash matches
+            if (entry.hash == hash && entry.name.size() == size && memcmp(entry.name.data(), name, size) == 0) return index;
+        }
+    }
+
+    /**
+     *  Change the number of slots
+     *  @param  capacity    The new number of slots (a power of two)
+     */
+    void rehash(size_t capacity)
+    {
+        // the old slots
+        std::vector<Entry> entries(capacity);
+        std::swap(entries, _entries);
+
+        // move the properties to the new slots
+        for (auto &entry : entries)
+        {
+            // skip free slots
+            if (!entry.property) continue;
+
+            // move it
+            _entries[locate(entry.name.data(), entry.name.size(), entry.hash)] = std::move(entry);
+        }
+    }
+
+public:
+    /**
+     *  Add a property, or replace it if it already exists
+     *  @param  name        Name of the property
+     *  @param  property    The property
+     */
+    void set(const std::string &name, std::shared_ptr<Property> property)
+    {
+        // keep at least half of the slots free, so that the probe sequences stay short
+        if ((_count + 1) * 2 > _entries.size()) rehash(std::max<size_t>(8, _entries.size() * 2));
+
+        // calculate the hash
+        ulong code = hash(name.data(), name.size());
+
+        // find the slot for it
+        Entry &entry = _entries[locate(name.data(), name.size(), code)];
+
+        // is this a new property?
+        if (!entry.property)
+        {
+            // store the name
+            entry.hash = code;
+            entry.name = name;
+            _count += 1;
+        }
+
+        // store the property
+        entry.property = std::move(property);
+    }
+
+    /**
+     *  Find a property
+     *  @param  name        Name of the property
+     *  @param  size        Size of the name
+     *  @param  hash        Hash of the name
+     *  @return Property    The property, or nullptr if it does not exist
+     */
+    Property *find(const char *name, size_t size, ulong hash) const
+    {
+        // the table is empty for most classes
+        if (_count == 0) return nullptr;
+
+        // look up the slot
+        return _entries[locate(name, size, hash)].property.get();
+    }
+
+    /**
+     *  Find a property
+     *  @param  name        Name of the property
+     *  @param  size        Size of the name
+     *  @return Property    The property, or nullptr if it does not exist
+     */
+    Property *find(const char *name, size_t size) const
+    {
+        // the table is empty for most classes
+        if (_count == 0) return nullptr;
+
+        // calculate the hash, and look up the slot
+        return _entries[locate(name, size, hash(name, size))].property.get();
+    }
+
+    /**
+     *  Find a property
+     *  @param  name        Name of the property
+     *  @return Property    The property, or nullptr if it does not exist
+     */
+    Property *find(const std::string &name) const
+    {
+        return find(name.data(), name.size());
+    }
+
+#if PHP_VERSION_ID >= 50399
+
+    /**
+     *  Find a property by the name that the engine passes to the property handlers
+     *  @param  name        Name of the property (a string)
+     *  @param  key         Literal with the precalculated hash, or nullptr
+     *  @return Property    The property, or nullptr if it does not exist
+     */
+    Property *find(const zval *name, const zend_literal *key) const
+    {
+        // use the hash that the engine already calculated (if it is there)
+        if (key && key->hash_value) return find(Z_STRVAL_P(name), Z_STRLEN_P(name), key->hash_value);
+
+        // calculate the hash ourselves
+        return find(Z_STRVAL_P(name), Z_STRLEN_P(name));
+    }
+
+#endif
+};
+
+/**
+ *  End of namespace
+ */
+}
@@ -0,0 +1,124 @@
+/**
+ *  StringBuilder.cpp
+ *
+ *  Implementation of the StringBuilder class
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2019 Copernica BV
+ */
+#include "includes.h"
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Constructor that immediately allocates a buffer
+ *  @param  capacity    The expected size of the string
+ */
+StringBuilder::StringBuilder(size_t capacity)
+{
+    // allocate the buffer right away
+    reserve(capacity);
+}
+
+/**
+ *  Move constructor
+ *  @param  that
+ */
+StringBuilder::StringBuilder(StringBuilder &&that) _NOEXCEPT :
+    _buffer(that._buffer), _size(that._size), _capacity(that._capacity)
+{
+    // the other object no longer owns the buffer
+    that._buffer = nullptr;
+    that._size = that._capacity = 0;
+}
+
+/**
+ *  Destructor
+ */
+StringBuilder::~StringBuilder()
+{
+    // release the buffer if it was not handed over to a value
+    if (_buffer) efree(_buffer);
+}
+
+/**
+ *  Make sure that a number of bytes can be appended without reallocation
+ *  @param  size        Number of bytes that are going to be written
+ *  @return char*       Pointer where the data can be written
+ */
+char *StringBuilder::reserve(size_t size)
+{
+    // is the buffer already big enough?
+    if (_size + size <= _capacity) return _buffer + _size;
+
+    // grow exponentially, to prevent that each append() causes a reallocation
+    size_t capacity = _size + size > _capacity * 2 ? _size + size : _capacity * 2;
+
+    // allocate or grow the buffer (one extra byte for the terminating null)
+    _buffer = (char *)(_buffer ? erealloc(_buffer, capacity + 1) : emalloc(capacity + 1));
+
+    // store the new capacity
+    _capacity = capacity;
+
+    // done
+    return _buffer + _size;
+}
+
+/**
+ *  Append data to the string
+ *  @param  data        The data to append
+ *  @param  size        Size of the data
+ *  @return StringBuilder
+ */
+StringBuilder &StringBuilder::append(const char *data, size_t size)
+{
+    // copy the data to the buffer
+    memcpy(reserve(size), data, size);
+
+    // update the size
+    _size += size;
+
+    // allow chaining
+    return *this;
+}
+
+/**
+ *  Hand over the buffer to a Php::Value
+ *  @return Value
+ */
+Value StringBuilder::value()
+{
+    // make sure that there is a buffer, even for empty strings, and give back
+    // the memory that was reserved for growing, the zval keeps the buffer as it is
+    if (!_buffer) _buffer = (char *)emalloc(1);
+    else if (_capacity > _size) _buffer = (char *)erealloc(_buffer, _size + 1);
+
+    // zend expects strings to be null-terminated (there is always room for this)
+    _buffer[_size] = 0;
+
+    // allocate a zval that takes over the buffer (duplicate=0 means no copy)
+    zval *val;
+    MAKE_STD_ZVAL(val);
+    ZVAL_STRINGL(val, _buffer, _size, 0);
+
+    // the buffer is now owned by the zval
+    _buffer = nullptr;
+    _size = _capacity = 0;
+
+    // wrap it using the Value(zval*) constructor, this will +1 the refcount
+    Value result(val);
+
+    // -1 the refcount to avoid future leaks
+    Z_DELREF_P(val);
+
+    // done
+    return result;
+}
+
+/**
+ *  End of namespace
+ */
+}
@@ -0,0 +1,29 @@
+/**
+ *  StringView.cpp
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2019 Copernica BV
+ */
+#include "includes.h"
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Custom output stream operator
+ *  @param  stream
+ *  @param  value
+ *  @return ostream
+ */
+std::ostream &operator<<(std::ostream &stream, const StringView &value)
+{
+    return stream.write(value.data(), value.size());
+}
+
+/**
+ *  End of namespace
+ */
+}
+
@@ -0,0 +1,397 @@
+/**
+ *  TypedFunctionBase.cpp
+ *
+ *  Implementation of the parts of the typed functions that do not depend
+ *  on the signature. The conversions follow the rules that
+ *  zend_parse_parameters() uses for the builtin PHP functions.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2019 Copernica BV
+ */
+#include "includes.h"
+#include "conversion.h"
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Report that an argument has the wrong type
+ *  @param  argument        The argument
+ *  @param  index           Index of the argument
+ *  @param  expected        Name of the expected type
+ *  @return bool            Always false
+ */
+static bool mismatch(zval *argument, int index, const char *expected)
+{
+    // we need the tsrm_ls variable
+    TSRMLS_FETCH();
+
+    // the same warning as zend_parse_parameters() gives
+    Php::warning << get_active_function_name(TSRMLS_C) << "() expects parameter " << (index + 1) << " to be " << expected << ", " << zend_zval_type_name(argument) << " given" << std::flush;
+
+    // the argument could not be converted
+    return false;
+}
+
+/**
+ *  Check the number of arguments
+ *  @param  provided        The number of arguments provided
+ *  @param  expected        The number of arguments of the function
+ *  @param  return_value    The return value to set on failure
+ *  @return bool
+ */
+bool TypedFunctionBase::count(int provided, int expected, struct _zval_struct *return_value)
+{
+    // is the number of arguments correct?
+    if (provided == expected) return true;
+
+    // we need the tsrm_ls variable
+    TSRMLS_FETCH();
+
+    // the same warning as zend_parse_parameters() gives
+    Php::warning << get_active_function_name(TSRMLS_C) << "() expects exactly " << expected << (expected == 1 ? " parameter, " : " parameters, ") << provided << " given" << std::flush;
+
+    // set the return value to NULL
+    RETVAL_NULL();
+
+    // we are not in a valid state
+    return false;
+}
+
+/**
+ *  Get the arguments from the PHP stack
+ *  @param  provided        The number of arguments provided
+ *  @return                 Pointer to the first argument
+ */
+struct _zval_struct **TypedFunctionBase::arguments(int provided)
+{
+    // we need the tsrm_ls variable
+    TSRMLS_FETCH();
+
+    // the arguments are on top of the stack, followed by the argument count
+    return (zval **) (zend_vm_stack_top(TSRMLS_C) - 1 - provided);
+}
+
+/**
+ *  Convert an argument into a boolean
+ *  @param  argument        Pointer to the argument on the stack
+ *  @param  index           Index of the argument
+ *  @param  result          Variable to store the result in
+ *  @return bool
+ */
+bool TypedFunctionBase::decode(struct _zval_struct **argument, int index, bool &result)
+{
+    // check the type
+    switch (Z_TYPE_PP(argument)) {
+    case IS_NULL:
+    case IS_BOOL:
+    case IS_LONG:
+    case IS_DOUBLE:
+    case IS_STRING:     result = Conversion::boolValue(*argument); return true;
+    default:            return mismatch(*argument, index, "boolean");
+    }
+}
+
+/**
+ *  Convert an argument into an integer
+ *  @param  argument        Pointer to the argument on the stack
+ *  @param  index           Index of the argument
+ *  @param  result          Variable to store the result in
+ *  @return bool
+ */
+bool TypedFunctionBase::decode(struct _zval_struct **argument, int index, int64_t &result)
+{
+    // the argument
+    zval *value = *argument;
+
+    // a floating point number that is parsed from a string
+    double number;
+
+    // check the type
+    switch (Z_TYPE_P(value)) {
+    case IS_LONG:       result = Z_LVAL_P(value); return true;
+    case IS_NULL:       result = 0; return true;
+    case IS_BOOL:       result = Z_BVAL_P(value); return true;
+    case IS_DOUBLE:     number = Z_DVAL_P(value); break;
+    case IS_STRING:
+        {
+            // the string should hold a number
+            long integer;
+            switch (is_numeric_string(Z_STRVAL_P(value), Z_STRLEN_P(value), &integer, &number, -1)) {
+            case IS_LONG:   result = integer; return true;
+            case IS_DOUBLE: break;
+            default:        return mismatch(value, index, "long");
+            }
+            break;
+        }
+    default:            return mismatch(value, index, "long");
+    }
+
+    // round the number (like zend_parse_parameters(), numbers that do not
+    // fit in an integer are not rejected, but wrapped by zend_dval_to_lval())
+    result = zend_dval_to_lval(number);
+    return true;
+}
+
+/**
+ *  Convert an argument into a floating point number
+ *  @param  argument        Pointer to the argument on the stack
+ *  @param  index           Index of the argument
+ *  @param  result          Variable to store the result in
+ *  @return bool
+ */
+bool TypedFunctionBase::decode(struct _zval_struct **argument, int index, double &result)
+{
+    // the argument
+    zval *value = *argument;
+
+    // check the type
+    switch (Z_TYPE_P(value)) {
+    case IS_DOUBLE:     result = Z_DVAL_P(value); return true;
+    case IS_LONG:       result = Z_LVAL_P(value); return true;
+    case IS_NULL:       result = 0.0; return true;
+    case IS_BOOL:       result = Z_BVAL_P(value); return true;
+    case IS_STRING:
+        {
+            // the string should hold a number
+            long integer;
+            switch (is_numeric_string(Z_STRVAL_P(value), Z_STRLEN_P(value), &integer, &result, -1)) {
+            case IS_LONG:   result = integer; return true;
+            case IS_DOUBLE: return true;
+            default:        return mismatch(value, index, "double");
+            }
+        }
+    default:            return mismatch(value, index, "double");
+    }
+}
+
+/**
+ *  Convert an argument into a string (the argument on the stack is converted,
+ *  just like zend_parse_parameters() does it)
+ *  @param  argument        Pointer to the argument on the stack
+ *  @param  index           Index of the argument
+ *  @return bool
+ */
+static bool stringify(zval **argument, int index)
+{
+    // check the type
+    switch (Z_TYPE_PP(argument)) {
+    case IS_STRING:
+        // nothing to convert
+        return true;
+
+    case IS_NULL:
+    case IS_BOOL:
+    case IS_LONG:
+    case IS_DOUBLE:
+        // convert the scalar into a string (this separates the variable first)
+        convert_to_string_ex(argument);
+        return true;
+
+    case IS_OBJECT:
+        {
+            // we need the tsrm_ls variable
+            TSRMLS_FETCH();
+
+            // the object should have a __toString() method
+            if (!Z_OBJ_HANDLER_PP(argument, cast_object)) break;
+
+            // separate the variable, and let the object convert itself
+            SEPARATE_ZVAL_IF_NOT_REF(argument);
+            zval *value = *argument;
+            zval result;
+            if (Z_OBJ_HANDLER_P(value, cast_object)(value, &result, IS_STRING TSRMLS_CC) != SUCCESS) break;
+
+            // replace the object with the string
+            zval_dtor(value);
+            ZVAL_COPY_VALUE(value, &result);
+            return true;
+        }
+
+    default:
+        break;
+    }
+
+    // the argument can not be used as a string
+    return mismatch(*argument, index, "string");
+}
+
+/**
+ *  Convert an argument into a string
+ *  @param  argument        Pointer to the argument on the stack
+ *  @param  index           Index of the argument
+ *  @param  result          Variable to store the result in
+ *  @return bool
+ */
+bool TypedFunctionBase::decode(struct _zval_struct **argument, int index, std::string &result)
+{
+    // convert the argument
+    if (!stringify(argument, index)) return false;
+
+    // copy the string
+    result.assign(Z_STRVAL_PP(argument), Z_STRLEN_PP(argument));
+    return true;
+}
+
+/**
+ *  Convert an argument into a string view
+ *  @param  argument        Pointer to the argument on the stack
+ *  @param  index           Index of the argument
+ *  @param  result          Variable to store the result in
+ *  @return bool
+ */
+bool TypedFunctionBase::decode(struct _zval_struct **argument, int index, StringView &result)
+{
+    // convert the argument
+    if (!stringify(argument, index)) return false;
+
+    // refer to the string on the stack
+    result = StringView(Z_STRVAL_PP(argument), Z_STRLEN_PP(argument));
+    return true;
+}
+
+/**
+ *  Refer to an argument (for a ValueRef)
+ *  @param  argument        Pointer to the argument on the stack
+ *  @param  index           Index of the argument
+ *  @param  result          Variable to store the result in
+ *  @return bool
+ */
+bool TypedFunctionBase::decode(struct _zval_struct **argument, int index, struct _zval_struct *&result)
+{
+    // any type is accepted
+    result = *argument;
+    return true;
+}
+
+/**
+ *  Wrap an argument in a value
+ *  @param  argument        Pointer to the argument on the stack
+ *  @param  index           Index of the argument
+ *  @param  result          Variable to store the result in
+ *  @return bool
+ */
+bool TypedFunctionBase::decode(struct _zval_struct **argument, int index, Value &result)
+{
+    // any type is accepted
+    result = Value(*argument);
+    return true;
+}
+
+/**
+ *  Wrap an argument of a certain type in a value
+ *  @param  argument        Pointer to the argument on the stack
+ *  @param  index           Index of the argument
+ *  @param  result          Variable to store the result in
+ *  @param  type            The required type
+ *  @return bool
+ */
+bool TypedFunctionBase::decode(struct _zval_struct **argument, int index, Value &result, Type type)
+{
+    // check the type
+    if (Z_TYPE_PP(argument) != (int)type) return mismatch(*argument, index, type == Type::Array ? "array" : "object");
+
+    // wrap the argument
+    result = Value(*argument);
+    return true;
+}
+
+/**
+ *  Set the function to return null because the arguments were invalid
+ *  @param  return_value
+ */
+void TypedFunctionBase::invalid(struct _zval_struct *return_value)
+{
+    // the same as zend_parse_parameters() failures
+    RETVAL_NULL();
+}
+
+/**
+ *  Store the return value
+ *  @param  return_value
+ *  @param  value
+ */
+void TypedFunctionBase::encode(struct _zval_struct *return_value, std::nullptr_t value)
+{
+    RETVAL_NULL();
+}
+
+/**
+ *  Store the return value
+ *  @param  return_value
+ *  @param  value
+ */
+void TypedFunctionBase::encode(struct _zval_struct *return_value, bool value)
+{
+    RETVAL_BOOL(value);
+}
+
+/**
+ *  Store the return value
+ *  @param  return_value
+ *  @param  value
+ */
+void TypedFunctionBase::encode(struct _zval_struct *return_value, int64_t value)
+{
+    RETVAL_LONG(value);
+}
+
+/**
+ *  Store the return value
+ *  @param  return_value
+ *  @param  value
+ */
+void TypedFunctionBase::encode(struct _zval_struct *return_value, double value)
+{
+    RETVAL_DOUBLE(value);
+}
+
+/**
+ *  Store the return value
+ *  @param  return_value
+ *  @param  value
+ */
+void TypedFunctionBase::encode(struct _zval_struct *return_value, const std::string &value)
+{
+    RETVAL_STRINGL(value.data(), value.size(), 1);
+}
+
+/**
+ *  Store the return value
+ *  @param  return_value
+ *  @param  value
+ */
+void TypedFunctionBase::encode(struct _zval_struct *return_value, const StringView &value)
+{
+    RETVAL_STRINGL(value.data(), value.size(), 1);
+}
+
+/**
+ *  Store the return value
+ *  @param  return_value
+ *  @param  value
+ */
+void TypedFunctionBase::encode(struct _zval_struct *return_value, Value &&value)
+{
+    value.moveTo(return_value);
+}
+
+/**
+ *  Handle exceptions
+ *  @param  exception
+ */
+void TypedFunctionBase::handle(Throwable &exception)
+{
+    // we need the tsrm_ls variable
+    TSRMLS_FETCH();
+
+    // pass it on to the exception handler
+    process(exception TSRMLS_CC);
+}
+
+/**
+ *  End of namespace
+ */
+}
@@ -0,0 +1,65 @@
+/**
+ *  Utf8.h
+ *
+ *  Helper function to decode and check one UTF-8 encoded character. It
+ *  rejects everything that PHP's json functions reject as well: invalid
+ *  and missing bytes, overlong encodings, surrogates and code points that
+ *  are too big for unicode.
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2019 Copernica BV
+ */
+
+/**
+ *  Include guard
+ */
+#pragma once
+
+/**
+ *  Begin of namespace
+ */
+namespace Php {
+
+/**
+ *  Decode one UTF-8 encoded character, this throws an exception for
+ *  malformed input
+ *  @param  current     Pointer to the character, moved to the next character
+ *  @param  end         End of the string
+ *  @return uint32_t    The code point
+ */
+inline uint32_t utf8(const unsigned char *&current, const unsigned char *end)
+{
+    // the first byte tells how many bytes follow
+    unsigned char byte = *current++;
+
+    // control characters and ascii
+    if (byte < 0x80) return byte;
+
+    // number of continuation bytes, and the minimum code point (to detect overlong encodings)
+    int count; uint32_t codepoint, minimum;
+    if ((byte & 0xe0) == 0xc0) { count = 1; codepoint = byte & 0x1f; minimum = 0x80; }
+    else if ((byte & 0xf0) == 0xe0) { count = 2; codepoint = byte & 0x0f; minimum = 0x800; }
+    else if ((byte & 0xf8) == 0xf0) { count = 3; codepoint = byte & 0x07; minimum = 0x10000; }
+    else throw Exception("Malformed UTF-8 characters, possibly incorrectly encoded");
+
+    // read the continuation bytes
+    for (int i = 0; i < count; ++i)
+    {
+        // the byte must exist, and be a continuation byte
+        if (current == end || (*current & 0xc0) != 0x80) throw Exception("Malformed UTF-8 characters, possibly incorrectly encoded");
+
+        // add the bits
+        codepoint = (codepoint << 6) | (*current++ & 0x3f);
+    }
+
+    // check for overlong encodings, surrogates and too big numbers
+    if (codepoint < minimum || (codepoint >= 0xd800 && codepoint < 0xe000) || codepoint > 0x10ffff) throw Exception("Malformed UTF-8 characters, possibly incorrectly encoded");
+
+    // done
+    return codepoint;
+}
+
+/**
+ *  End of namespace
+ */
+}
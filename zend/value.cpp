@@ -26,6 +26,9 @@
  */
 #include "includes.h"
 #include "lowercase.h"
+#include "conversion.h"
+#include "methodcache.h"
+#include "keytable.h"
 
 /**
  *  Set up namespace
@@ -152,6 +155,20 @@ Value::Value(double value)
     ZVAL_DOUBLE(_val, value);
 }
 
+/**
+ *  Constructor from a local value
+ *  @param  value
+ */
+Value::Value(const LocalValue &value)
+{
+    // allocate the zval, and copy the inline zval into it
+    ALLOC_ZVAL(_val);
+    INIT_PZVAL_COPY(_val, value.val());
+
+    // strings have to be duplicated, the local value keeps its own buffer
+    zval_copy_ctor(_val);
+}
+
 /**
  *  Wrap object around zval
  *  @param  zval        Value to wrap
@@ -343,6 +360,48 @@ zval *Value::detach(bool keeprefcount)
     return result;
 }
 
+/**
+ *  Move the value into the return value of a function
+ *
+ *  @param  return_value        The return value
+ *  @param  return_value_ptr    Pointer to the return value (may be nullptr)
+ */
+void Value::moveTo(zval *return_value, zval **return_value_ptr)
+{
+    // a value that was already moved is returned as null
+    if (!_val) { RETVAL_NULL(); return; }
+
+    // if nobody else holds the variable, its contents can simply be moved
+    if (Z_REFCOUNT_P(_val) == 1)
+    {
+        // take over the contents, and free the empty container
+        ZVAL_COPY_VALUE(return_value, _val);
+        FREE_ZVAL(_val);
+    }
+
+#if PHP_VERSION_ID >= 50600
+
+    // the variable is shared, but the return value can share it too (this
+    // is what RETVAL_ZVAL_FAST does), our reference is handed over
+    else if (return_value_ptr && !Z_ISREF_P(_val))
+    {
+        zval_ptr_dtor(return_value_ptr);
+        *return_value_ptr = _val;
+    }
+
+#endif
+
+    // references can not be shared, the return value gets its own copy
+    else
+    {
+        RETVAL_ZVAL(_val, 1, 0);
+        zval_ptr_dtor(&_val);
+    }
+
+    // the object no longer holds the variable
+    _val = nullptr;
+}
+
 /**
  *  Retrieve the refcount
  *  @return int
@@ -671,6 +730,38 @@ Value &Value::operator=(const HashMember<int> &value)
     return operator=(value.value());
 }
 
+/**
+ *  Assignment operator
+ *  @param  value
+ *  @return Value
+ */
+Value &Value::operator=(const HashMember<Key> &value)
+{
+    // assign value object
+    return operator=(value.value());
+}
+
+/**
+ *  Assignment operator
+ *  @param  value
+ *  @return Value
+ */
+Value &Value::operator=(const LocalValue &value)
+{
+    // if this is not a reference variable, we should detach it to implement copy on write
+    SEPARATE_ZVAL_IF_NOT_REF(&_val);
+
+    // deallocate current zval (without cleaning the zval structure)
+    zval_dtor(_val);
+
+    // copy the inline zval, strings have to be duplicated
+    ZVAL_COPY_VALUE(_val, value.val());
+    zval_copy_ctor(_val);
+
+    // update the object
+    return *this;
+}
+
 /**
  *  Add a value to the object
  *  @param  value
@@ -836,56 +927,74 @@ Value Value::operator()() const
 }
 
 /**
- *  Is a method with the given name callable?
- *
- *  This is only applicable when the Value contains a PHP object
- *
- *  @param  name        Name of the function
- *  @return boolean
+ *  Helper function to look up a method of an object. The result is stored in
+ *  the method cache, so that the next lookup for the same class and name does
+ *  not have to convert the name to lowercase or probe the function table
+ *  @param  object      The object
+ *  @param  name        Name of the method
+ *  @param  len         Length of the name
+ *  @return MethodCache::Entry
  */
-bool Value::isCallable(const char *name)
+static const MethodCache::Entry *lookup(zval **object, const char *name, size_t len)
 {
-    // this only makes sense if we are an object
-    if (!isObject()) return false;
+    // get the class properties
+    zend_class_entry *ce = Z_OBJCE_P(*object);
+
+    // perhaps we already looked up this method before
+    auto *entry = MethodCache::find(ce, name, len);
+    if (entry) return entry;
 
     // make sure the zend thread safety variable is available
     TSRMLS_FETCH();
 
-    // get the class properties
-    zend_class_entry *ce = Z_OBJCE_P(_val);
-    
-    // length of the name
-    size_t len = ::strlen(name);
-
     // convert name to lowercase
     LowerCase methodname(name, len);
-    
+
+    // the method from the function table
+    zend_function *function = nullptr;
+
     // check if thus function exists
-    if (zend_hash_exists(&ce->function_table, methodname, len+1)) return true;
-    
+    if (zend_hash_find(&ce->function_table, methodname, len+1, (void **)&function) == SUCCESS) return MethodCache::store(ce, name, len, function, true);
+
     // can we dynamically fetch the method?
-    if (Z_OBJ_HT_P(_val)->get_method == nullptr) return false;
-    
+    if (Z_OBJ_HT_P(*object)->get_method == nullptr) return MethodCache::store(ce, name, len, nullptr, false);
+
     // get the function
-	auto *func = Z_OBJ_HT_P(_val)->get_method(&_val, methodname, len, nullptr TSRMLS_CC);
-    
-    // if function does not exist, we do not have to check further
-    if (func == nullptr) return false;
+    auto *func = Z_OBJ_HT_P(*object)->get_method(object, methodname, len, nullptr TSRMLS_CC);
 
-    // is it a special internal function, otherwise it is not callable
-    if (func->type != ZEND_INTERNAL_FUNCTION) return false;
+    // if function does not exist, we do not have to check further
+    if (func == nullptr) return MethodCache::store(ce, name, len, nullptr, false);
 
-    // copied from zend_builtin_functions.c
-    if ((func->common.fn_flags & ZEND_ACC_CALL_VIA_HANDLER) == 0) return false;
+    // copied from zend_builtin_functions.c, only functions that are called
+    // via a handler are temporary, other functions are not callable
+    if ((func->common.fn_flags & ZEND_ACC_CALL_VIA_HANDLER) == 0) return MethodCache::store(ce, name, len, nullptr, false);
 
     // Returns true to the fake Closure's __invoke
-    bool result = func->common.scope == zend_ce_closure && (len == sizeof(ZEND_INVOKE_FUNC_NAME)-1) && memcmp(methodname, ZEND_INVOKE_FUNC_NAME, sizeof(ZEND_INVOKE_FUNC_NAME)-1) == 0;
-        
-    // clean resources
+    bool result = func->type == ZEND_INTERNAL_FUNCTION && func->common.scope == zend_ce_closure && (len == sizeof(ZEND_INVOKE_FUNC_NAME)-1) && memcmp(methodname, ZEND_INVOKE_FUNC_NAME, sizeof(ZEND_INVOKE_FUNC_NAME)-1) == 0;
+
+    // clean resources, the name was allocated too (just like method_exists() does)
+    if (func->common.function_name) efree((char *)func->common.function_name);
     efree(func);
-    
+
     // done
-    return result;
+    return MethodCache::store(ce, name, len, nullptr, result);
+}
+
+/**
+ *  Is a method with the given name callable?
+ *
+ *  This is only applicable when the Value contains a PHP object
+ *
+ *  @param  name        Name of the function
+ *  @return boolean
+ */
+bool Value::isCallable(const char *name)
+{
+    // this only makes sense if we are an object
+    if (!isObject()) return false;
+
+    // look up the method
+    return lookup(&_val, name, ::strlen(name))->callable;
 }
 
 /**
@@ -910,6 +1019,39 @@ Value Value::call(const char *name)
     return exec(name, 0, NULL);
 }
 
+/**
+ *  Helper function that processes the return value of a call
+ *  @param  oldException    The exception that was active before the call
+ *  @param  retval          The return value
+ *  @return Value
+ */
+static Value do_return(zval *oldException, zval *retval TSRMLS_DC)
+{
+    // was an exception thrown inside the function? In that case we throw a C++ new exception
+    // to give the C++ code the chance to catch it
+    if (oldException != EG(exception) && EG(exception))
+    {
+        // the return value is no longer needed
+        if (retval) zval_ptr_dtor(&retval);
+
+        // throw the exception
+        throw OrigException(EG(exception) TSRMLS_CC);
+    }
+
+    // leap out if nothing was returned
+    if (!retval) return nullptr;
+
+    // wrap the retval in a value
+    Php::Value result(retval);
+
+    // destruct the retval (this just decrements the refcounter, which is ok, because
+    // it is already wrapped in a Php::Value so still has 1 reference)
+    zval_ptr_dtor(&retval);
+
+    // done
+    return result;
+}
+
 /**
  *  Helper function that runs the actual call
  *  @param  object      The object to call it on
@@ -942,23 +1084,82 @@ static Value do_exec(zval *const *object, zval *method, int argc, zval ***params
     }
     else
     {
-        // was an exception thrown inside the function? In that case we throw a C++ new exception
-        // to give the C++ code the chance to catch it
-        if (oldException != EG(exception) && EG(exception)) throw OrigException(EG(exception) TSRMLS_CC);
-        
-        // leap out if nothing was returned
-        if (!retval) return nullptr;
-        
-        // wrap the retval in a value
-        Php::Value result(retval);
-        
-        // destruct the retval (this just decrements the refcounter, which is ok, because
-        // it is already wrapped in a Php::Value so still has 1 reference)
-        zval_ptr_dtor(&retval);
+        // process the return value
+        return do_return(oldException, retval TSRMLS_CC);
+    }
+}
 
-        // done
-        return result;
+/**
+ *  Helper function that calls a method by its name
+ *  @param  object      The object to call it on
+ *  @param  name        Name of the method
+ *  @param  args        Number of arguments
+ *  @param  params      The parameters
+ *  @return Value
+ */
+static Value do_exec(zval *const *object, const char *name, int argc, zval ***params)
+{
+    // the length of the name
+    size_t len = ::strlen(name);
+
+    // for objects we can look up the method in the cache (we're casting the const
+    // away, the object is not changed by looking up one of its methods)
+    auto *entry = Z_TYPE_P(*object) == IS_OBJECT ? lookup((zval **)object, name, len) : nullptr;
+
+    // the flags of the method
+    zend_uint flags = entry && entry->function ? entry->function->common.fn_flags : 0;
+
+    // only regular public methods are called directly, zend has to check all
+    // other methods (private methods for example can not be called from here)
+    if ((flags & ZEND_ACC_PPP_MASK) != ZEND_ACC_PUBLIC || (flags & (ZEND_ACC_STATIC | ZEND_ACC_ABSTRACT | ZEND_ACC_CALL_VIA_HANDLER)))
+    {
+        // wrap the name in a Php::Value object to get a zval
+        Value method(name, len);
+
+        // call helper function
+        return do_exec(object, method._val, argc, params);
     }
+
+    // the return zval
+    zval *retval = nullptr;
+
+    // we need the tsrm_ls variable
+    TSRMLS_FETCH();
+
+    // the current exception
+    zval *oldException = EG(exception);
+
+    // the name of the method, zend only uses this for error messages, so there
+    // is no need to make a copy of it
+    zval method;
+    INIT_ZVAL(method);
+    ZVAL_STRINGL(&method, (char *)name, len, 0);
+
+    // the call info
+    zend_fcall_info info;
+    info.size = sizeof(zend_fcall_info);
+    info.function_table = &Z_OBJCE_P(*object)->function_table;
+    info.function_name = &method;
+    info.symbol_table = nullptr;
+    info.retval_ptr_ptr = &retval;
+    info.param_count = argc;
+    info.params = params;
+    info.object_ptr = *object;
+    info.no_separation = 1;
+
+    // the method that we found, so that zend does not have to look it up
+    zend_fcall_info_cache cache;
+    cache.initialized = 1;
+    cache.function_handler = entry->function;
+    cache.calling_scope = Z_OBJCE_P(*object);
+    cache.called_scope = Z_OBJCE_P(*object);
+    cache.object_ptr = *object;
+
+    // call the method
+    if (zend_call_function(&info, &cache TSRMLS_CC) != SUCCESS) throw Exception(std::string("Invalid call to ") + name);
+
+    // process the return value
+    return do_return(oldException, retval TSRMLS_CC);
 }
 
 /**
@@ -982,11 +1183,8 @@ Value Value::exec(int argc, zval ***params) const
  */
 Value Value::exec(const char *name, int argc, struct _zval_struct ***params) const
 {
-    // wrap the name in a Php::Value object to get a zval
-    Value method(name);
-
     // call helper function
-    return do_exec(&_val, method._val, argc, params);
+    return do_exec(&_val, name, argc, params);
 }
 
 /**
@@ -998,30 +1196,92 @@ Value Value::exec(const char *name, int argc, struct _zval_struct ***params) con
  */
 Value Value::exec(const char *name, int argc, struct _zval_struct ***params)
 {
-    // wrap the name in a Php::Value object to get a zval
-    Value method(name);
-
     // call helper function
-    return do_exec(&_val, method._val, argc, params);
+    return do_exec(&_val, name, argc, params);
 }
 
 /**
- *  Comparison operators== for hardcoded Value
- *  @param  value
+ *  Helper macro to combine the types of two zvals into one number
  */
-bool Value::operator==(const Value &value) const
+#define TYPE_PAIR(t1,t2) (((t1) << 4) | (t2))
+
+/**
+ *  Helper function to compare two zvals. Pairs of scalars are compared
+ *  inline, other combinations are passed on to the zend engine
+ *  @param  left
+ *  @param  right
+ *  @param  result      Negative, zero or positive
+ *  @return bool        Was the comparison possible?
+ */
+static bool compareValues(zval *left, zval *right, long *result)
 {
+    // differences between floating point numbers are normalized, just like
+    // zend does it, so that NAN compares as equal
+    double difference;
+
+    // check the combination of types
+    switch (TYPE_PAIR(Z_TYPE_P(left), Z_TYPE_P(right))) {
+    case TYPE_PAIR(IS_LONG, IS_LONG):
+    case TYPE_PAIR(IS_BOOL, IS_BOOL):
+        // compare the integers without the risk of an overflow
+        *result = (Z_LVAL_P(left) > Z_LVAL_P(right)) - (Z_LVAL_P(left) < Z_LVAL_P(right));
+        return true;
+
+    case TYPE_PAIR(IS_DOUBLE, IS_DOUBLE):
+        difference = Z_DVAL_P(left) - Z_DVAL_P(right);
+        *result = ZEND_NORMALIZE_BOOL(difference);
+        return true;
+
+    case TYPE_PAIR(IS_LONG, IS_DOUBLE):
+        difference = (double)Z_LVAL_P(left) - Z_DVAL_P(right);
+        *result = ZEND_NORMALIZE_BOOL(difference);
+        return true;
+
+    case TYPE_PAIR(IS_DOUBLE, IS_LONG):
+        difference = Z_DVAL_P(left) - (double)Z_LVAL_P(right);
+        *result = ZEND_NORMALIZE_BOOL(difference);
+        return true;
+
+    case TYPE_PAIR(IS_NULL, IS_NULL):
+        *result = 0;
+        return true;
+
+    case TYPE_PAIR(IS_STRING, IS_STRING): {
+        // strings that share the same buffer are equal
+        if (Z_STRVAL_P(left) == Z_STRVAL_P(right)) { *result = 0; return true; }
+
+        // this is the same function that zend uses, it also deals with numeric strings
+        zval output;
+        zendi_smart_strcmp(&output, left, right);
+        *result = Z_LVAL(output);
+        return true;
+    }}
+
     // we need the tsrm_ls variable
     TSRMLS_FETCH();
 
     // zval that will hold the result of the comparison
-    zval result;
+    zval output;
 
     // run the comparison
-    if (SUCCESS != compare_function(&result, _val, value._val TSRMLS_CC)) return false;
+    if (SUCCESS != compare_function(&output, left, right TSRMLS_CC)) return false;
 
-    // convert to boolean
-    return result.value.lval == 0;
+    // expose the result
+    *result = Z_LVAL(output);
+    return true;
+}
+
+/**
+ *  Comparison operators== for hardcoded Value
+ *  @param  value
+ */
+bool Value::operator==(const Value &value) const
+{
+    // the result of the comparison
+    long result;
+
+    // compare the values
+    return compareValues(_val, value._val, &result) && result == 0;
 }
 
 /**
@@ -1031,17 +1291,25 @@ bool Value::operator==(const Value &value) const
  */
 bool Value::operator<(const Value &value) const
 {
-    // we need the tsrm_ls variable
-    TSRMLS_FETCH();
+    // the result of the comparison
+    long result;
 
-    // zval that will hold the result of the comparison
-    zval result;
+    // compare the values
+    return compareValues(_val, value._val, &result) && result < 0;
+}
 
-    // run the comparison
-    if (SUCCESS != compare_function(&result, _val, value._val TSRMLS_CC)) return false;
+/**
+ *  Compare the value with a string
+ *  @param  value
+ *  @return int
+ */
+int Value::compare(const std::string &value) const
+{
+    // strings can be compared without making a copy
+    if (isString()) return StringView(Z_STRVAL_P(_val), Z_STRLEN_P(_val)).compare(StringView(value));
 
-    // convert to boolean
-    return result.value.lval < 0;
+    // other types are converted to a string first
+    return stringValue().compare(value);
 }
 
 /**
@@ -1263,8 +1531,8 @@ int64_t Value::numericValue() const
     // already a long?
     if (isNumeric()) return Z_LVAL_P(_val);
 
-    // make a clone
-    return clone(Type::Numeric).numericValue();
+    // convert without making a clone
+    return Conversion::numericValue(_val);
 }
 
 /**
@@ -1276,8 +1544,8 @@ bool Value::boolValue() const
     // already a bool?
     if (isBool()) return Z_BVAL_P(_val);
 
-    // make a clone
-    return clone(Type::Bool).boolValue();
+    // convert without making a clone
+    return Conversion::boolValue(_val);
 }
 
 /**
@@ -1289,8 +1557,8 @@ std::string Value::stringValue() const
     // already a string?
     if (isString()) return std::string(Z_STRVAL_P(_val), Z_STRLEN_P(_val));
 
-    // make a clone
-    return clone(Type::String).stringValue();
+    // convert without making a clone
+    return Conversion::stringValue(_val);
 }
 
 /**
@@ -1351,6 +1619,21 @@ const char *Value::rawValue() const
     return nullptr;
 }
 
+/**
+ *  Get a borrowed view on the string buffer. Note that this only works
+ *  for string variables - other variables return an empty view.
+ *
+ *  @return StringView
+ */
+StringView Value::stringView() const
+{
+    // must be a string
+    if (isString()) return StringView(Z_STRVAL_P(_val), Z_STRLEN_P(_val));
+
+    // there is no string to view
+    return StringView();
+}
+
 /**
  *  Retrieve the value as decimal
  *  @return double
@@ -1360,8 +1643,8 @@ double Value::floatValue() const
     // already a double
     if (isFloat()) return Z_DVAL_P(_val);
 
-    // make a clone
-    return clone(Type::Float).floatValue();
+    // convert without making a clone
+    return Conversion::floatValue(_val);
 }
 
 /**
@@ -1414,6 +1697,192 @@ int Value::size() const
     }
 }
 
+/**
+ *  Helper function to convert an array to a vector, by reading the values
+ *  straight from the buckets of the hash table
+ *  @param  val         The array
+ *  @param  convert     Function to convert a zval into the right type
+ *  @return std::vector
+ */
+template <typename T>
+static std::vector<T> extract(zval *val, T (*convert)(zval *))
+{
+    // result variable
+    std::vector<T> result;
+
+    // only works for arrays, other types return an empty vector
+    if (Z_TYPE_P(val) != IS_ARRAY) return result;
+
+    // the hash table, and the number of elements in it
+    HashTable *table = Z_ARRVAL_P(val);
+    size_t count = zend_hash_num_elements(table);
+
+    // reserve enough space
+    result.reserve(count);
+
+    // the bucket that is being processed
+    Bucket *bucket = table->pListHead;
+
+    // most arrays are regular lists with keys 0, 1, 2, et cetera, in that
+    // order, for those arrays we can walk over the buckets in order
+    for (size_t position = 0; bucket; bucket = bucket->pListNext, ++position)
+    {
+        // stop when the array turns out not to be a regular list
+        if (bucket->nKeyLength > 0 || bucket->h != position) break;
+
+        // convert the value
+        result.push_back(convert(*(zval **)bucket->pData));
+    }
+
+    // was the entire array a regular list?
+    if (!bucket) return result;
+
+    // the array is not a list, we look up the indexes one by one, just
+    // like the generic vectorValue() implementation does
+    result.clear();
+
+    // fill the result vector
+    for (size_t i = 0; i < count; i++)
+    {
+        // the element
+        zval **item;
+
+        // check if the index exists
+        if (zend_hash_index_find(table, i, (void **)&item) == FAILURE) continue;
+
+        // convert the value
+        result.push_back(convert(*item));
+    }
+
+    // done
+    return result;
+}
+
+/**
+ *  Helper function to convert an array to a map, by reading the keys and
+ *  values straight from the buckets of the hash table
+ *  @param  value       The array or object
+ *  @param  val         The zval of that same value
+ *  @param  convert     Function to convert a zval into the right type
+ *  @return std::map
+ */
+template <typename T>
+static std::map<std::string,T> extract(const Value &value, zval *val, T (*convert)(zval *))
+{
+    // result variable
+    std::map<std::string,T> result;
+
+    // objects are converted via the regular implementation, that knows how
+    // to deal with traversable objects and private properties
+    if (Z_TYPE_P(val) == IS_OBJECT)
+    {
+        // convert all values
+        for (auto &iter : value.mapValue()) result[iter.first] = iter.second.operator T();
+
+        // done
+        return result;
+    }
+
+    // only works for arrays, other types return an empty map
+    if (Z_TYPE_P(val) != IS_ARRAY) return result;
+
+    // the hash table to walk over
+    HashTable *table = Z_ARRVAL_P(val);
+
+    // walk over the buckets
+    for (Bucket *bucket = table->pListHead; bucket; bucket = bucket->pListNext)
+    {
+        // build the key (numeric keys are converted to strings)
+        std::string key = bucket->nKeyLength ? std::string(bucket->arKey, bucket->nKeyLength - 1) : std::to_string((long)bucket->h);
+
+        // convert and store the value
+        result[std::move(key)] = convert(*(zval **)bucket->pData);
+    }
+
+    // done
+    return result;
+}
+
+/**
+ *  Convert the object to a vector of integers
+ *  @return std::vector
+ */
+template <>
+std::vector<int64_t> Value::vectorValue<int64_t>() const
+{
+    return extract<int64_t>(_val, &Conversion::numericValue);
+}
+
+/**
+ *  Convert the object to a vector of floating point numbers
+ *  @return std::vector
+ */
+template <>
+std::vector<double> Value::vectorValue<double>() const
+{
+    return extract<double>(_val, &Conversion::floatValue);
+}
+
+/**
+ *  Convert the object to a vector of booleans
+ *  @return std::vector
+ */
+template <>
+std::vector<bool> Value::vectorValue<bool>() const
+{
+    return extract<bool>(_val, &Conversion::boolValue);
+}
+
+/**
+ *  Convert the object to a vector of strings
+ *  @return std::vector
+ */
+template <>
+std::vector<std::string> Value::vectorValue<std::string>() const
+{
+    return extract<std::string>(_val, &Conversion::stringValue);
+}
+
+/**
+ *  Convert the object to a map of integers
+ *  @return std::map
+ */
+template <>
+std::map<std::string,int64_t> Value::mapValue<int64_t>() const
+{
+    return extract<int64_t>(*this, _val, &Conversion::numericValue);
+}
+
+/**
+ *  Convert the object to a map of floating point numbers
+ *  @return std::map
+ */
+template <>
+std::map<std::string,double> Value::mapValue<double>() const
+{
+    return extract<double>(*this, _val, &Conversion::floatValue);
+}
+
+/**
+ *  Convert the object to a map of booleans
+ *  @return std::map
+ */
+template <>
+std::map<std::string,bool> Value::mapValue<bool>() const
+{
+    return extract<bool>(*this, _val, &Conversion::boolValue);
+}
+
+/**
+ *  Convert the object to a map of strings
+ *  @return std::map
+ */
+template <>
+std::map<std::string,std::string> Value::mapValue<std::string>() const
+{
+    return extract<std::string>(*this, _val, &Conversion::stringValue);
+}
+
 /**
  *  Convert the object to a map with string index and Php::Value value
  *  @return std::map
@@ -1423,13 +1892,184 @@ std::map<std::string,Php::Value> Value::mapValue() const
     // result variable
     std::map<std::string,Php::Value> result;
 
-    // iterate over the object
-    for (auto &iter : *this) result[iter.first.stringValue()] = iter.second;
+    // objects are iterated with the regular iterator, that knows how to deal
+    // with traversable objects and private properties
+    if (!isArray())
+    {
+        // iterate over the object
+        for (auto &iter : *this) result[iter.first.stringValue()] = iter.second;
+
+        // done
+        return result;
+    }
+
+    // the hash table to walk over
+    HashTable *table = Z_ARRVAL_P(_val);
+
+    // for arrays we can build the keys straight from the buckets, without
+    // constructing an intermediate Value object for each key
+    for (Bucket *bucket = table->pListHead; bucket; bucket = bucket->pListNext)
+    {
+        // build the key (numeric keys are converted to strings)
+        std::string key = bucket->nKeyLength ? std::string(bucket->arKey, bucket->nKeyLength - 1) : std::to_string((long)bucket->h);
+
+        // the value that is stored in the bucket
+        Value value(*(zval **)bucket->pData);
+
+        // store it, if the key was already in use the value is overwritten
+        auto inserted = result.emplace(std::move(key), value);
+        if (!inserted.second) inserted.first->second = std::move(value);
+    }
 
     // done
     return result;
 }
 
+/**
+ *  Visit all elements of an array or object
+ *  @param  numeric     Callback for elements with a numeric key
+ *  @param  string      Callback for elements with a string key
+ *  @param  data        The visitor that is passed to the callbacks
+ */
+void Value::forEach(void (*numeric)(void *data, int64_t key, const ValueRef &value), void (*string)(void *data, const StringView &key, const ValueRef &value), void *data) const
+{
+    // objects are iterated with the regular iterator, that knows how to deal
+    // with traversable objects and private properties
+    if (isObject())
+    {
+        // iterate over the object
+        for (auto &iter : *this)
+        {
+            // the value
+            ValueRef value(iter.second._val);
+
+            // pass on the key and the value
+            if (iter.first.isNumeric()) numeric(data, iter.first.numericValue(), value);
+            else string(data, StringView(iter.first.stringValue()), value);
+        }
+
+        // done
+        return;
+    }
+
+    // arrays are walked over without making copies of the keys and values
+    ValueRef(_val).forEach(numeric, string, data);
+}
+
+/**
+ *  Helper function to fill a container with the keys and values of an array
+ *  or object, numeric keys stay numeric
+ *  @param  value       The array or object
+ *  @param  val         The zval of that same value
+ *  @param  callback    Function that is called for every key and value
+ */
+template <typename Callback>
+static void walk(const Value &value, zval *val, const Callback &callback)
+{
+    // objects are iterated with the regular iterator, that knows how to deal
+    // with traversable objects and private properties
+    if (Z_TYPE_P(val) == IS_OBJECT)
+    {
+        // iterate over the object
+        for (auto &iter : value)
+        {
+            // convert the key
+            if (iter.first.isNumeric()) callback(Key(iter.first.numericValue()), iter.second);
+            else callback(Key(iter.first.stringValue()), iter.second);
+        }
+
+        // done
+        return;
+    }
+
+    // only works for arrays, other types are empty
+    if (Z_TYPE_P(val) != IS_ARRAY) return;
+
+    // the hash table to walk over
+    HashTable *table = Z_ARRVAL_P(val);
+
+    // walk over the buckets, the keys are built without hashing them again
+    for (Bucket *bucket = table->pListHead; bucket; bucket = bucket->pListNext)
+    {
+        // the value that is stored in the bucket
+        Value element(*(zval **)bucket->pData);
+
+        // pass on the key and value
+        if (bucket->nKeyLength == 0) callback(Key((int64_t)(long)bucket->h), element);
+        else callback(Key(bucket->arKey, bucket->nKeyLength - 1, bucket->h), element);
+    }
+}
+
+/**
+ *  Convert the object to an unordered map
+ *  @return std::unordered_map
+ */
+std::unordered_map<Key,Php::Value> Value::unorderedMapValue() const
+{
+    // result variable
+    std::unordered_map<Key,Php::Value> result;
+
+    // arrays know how many elements there are going to be
+    if (isArray()) result.reserve(size());
+
+    // fill the map (for objects the same key can show up more than once, the last one wins)
+    walk(*this, _val, [&result](Key &&key, const Value &value) {
+        result[std::move(key)] = value;
+    });
+
+    // done
+    return result;
+}
+
+/**
+ *  Convert the object to a vector of key-value pairs, sorted by key
+ *  @return std::vector
+ */
+std::vector<std::pair<Key,Php::Value>> Value::flatMapValue() const
+{
+    // result variable
+    std::vector<std::pair<Key,Php::Value>> result;
+
+    // arrays know how many elements there are going to be
+    if (isArray()) result.reserve(size());
+
+    // fill the vector
+    walk(*this, _val, [&result](Key &&key, const Value &value) {
+        result.emplace_back(std::move(key), value);
+    });
+
+    // sort the elements by their key
+    std::sort(result.begin(), result.end(), [](const std::pair<Key,Php::Value> &a, const std::pair<Key,Php::Value> &b) {
+        return a.first < b.first;
+    });
+
+    // done
+    return result;
+}
+
+/**
+ *  Turn the value into an array that has room for a certain number of elements
+ *  @param  size        Expected number of elements
+ */
+void Value::reserveArray(size_t size)
+{
+    // must be an array
+    setType(Type::Array);
+
+    // the table can only be resized when it is still empty
+    if (zend_hash_num_elements(Z_ARRVAL_P(_val)) > 0) return;
+
+    // if this is not a reference variable, we should detach it to implement copy on write
+    SEPARATE_ZVAL_IF_NOT_REF(&_val);
+
+    // the hash table to resize
+    HashTable *table = Z_ARRVAL_P(_val);
+
+    // initialize the table again, now with the right size
+    zend_hash_destroy(table);
+    zend_hash_init(table, size, nullptr, ZVAL_PTR_DTOR, 0);
+}
+
 /**
  *  Internal helper method to retrieve an iterator
  *  @param  begin       Should the iterator start at the begin
@@ -1573,6 +2213,20 @@ bool Value::contains(const char *key, int size) const
     }
 }
 
+/**
+ *  Does the array contain a certain key, using the precomputed hash
+ *  @param  key
+ *  @return bool
+ */
+bool Value::contains(const Key &key) const
+{
+    // objects and other types use the regular implementation
+    if (!isArray()) return contains(key.data(), key.size());
+
+    // check if the key is in the array, without hashing it again
+    return exists(Z_ARRVAL_P(_val), key);
+}
+
 /**
  *  Get access to a certain array member
  *  @param  index
@@ -1640,6 +2294,24 @@ Value Value::get(const char *key, int size) const
     }
 }
 
+/**
+ *  Get access to a certain assoc member, using the precomputed hash
+ *  @param  key
+ *  @return Value
+ */
+Value Value::get(const Key &key) const
+{
+    // objects and other types use the regular implementation
+    if (!isArray()) return get(key.data(), key.size());
+
+    // look up the key, without hashing it again
+    zval **result = find(Z_ARRVAL_P(_val), key);
+    if (!result) return Value();
+
+    // wrap the value
+    return Value(*result);
+}
+
 /**
  *  Set a certain property without performing any checks
  *  This method can be used when it is already known that the object is an array
@@ -1746,6 +2418,53 @@ void Value::set(const char *key, int size, const Value &value)
     setRaw(key, size, value);
 }
 
+/**
+ *  Set a certain property without running any checks, using the precomputed hash
+ *  @param  key
+ *  @param  value
+ */
+void Value::setRaw(const Key &key, const Value &value)
+{
+    // objects use the regular implementation
+    if (isObject()) return setRaw(key.data(), key.size(), value);
+
+    // does not work for empty keys
+    if (key.size() > 0 && key.data()[0] == 0) return;
+
+    // if this is not a reference variable, we should detach it to implement copy on write
+    SEPARATE_ZVAL_IF_NOT_REF(&_val);
+
+    // add the value (this will reduce the refcount of the current value)
+    update(Z_ARRVAL_P(_val), key, value._val);
+
+    // the variable has one more reference (the array entry)
+    Z_ADDREF_P(value._val);
+}
+
+/**
+ *  Set a certain property, using the precomputed hash
+ *  @param  key
+ *  @param  value
+ */
+void Value::set(const Key &key, const Value &value)
+{
+    // the current value
+    zval **current = isArray() ? find(Z_ARRVAL_P(_val), key) : nullptr;
+
+    // check if this key is already in the array
+    if (current)
+    {
+        // skip if nothing is going to change
+        if (value._val == *current) return;
+    }
+
+    // this should be an object or an array
+    if (!isObject()) setType(Type::Array);
+
+    // done
+    setRaw(key, value);
+}
+
 /**
  *  Unset a member by its index
  *  @param  index
@@ -1791,6 +2510,22 @@ void Value::unset(const char *key, int size)
     }
 }
 
+/**
+ *  Unset a member, using the precomputed hash
+ *  @param  key
+ */
+void Value::unset(const Key &key)
+{
+    // objects use the regular implementation
+    if (!isArray()) return unset(key.data(), key.size());
+
+    // if this is not a reference variable, we should detach it to implement copy on write
+    SEPARATE_ZVAL_IF_NOT_REF(&_val);
+
+    // remove the key, without hashing it again
+    remove(Z_ARRVAL_P(_val), key);
+}
+
 /**
  *  Array access operator
  *  This can be used for accessing arrays
@@ -1834,6 +2569,17 @@ HashMember<std::string> Value::operator[](const char *key)
     return HashMember<std::string>(this, key);
 }
 
+/**
+ *  Array access operator
+ *  This can be used for accessing associative arrays with a precomputed key
+ *  @param  key
+ *  @return HashMember
+ */
+HashMember<Key> Value::operator[](const Key &key)
+{
+    return HashMember<Key>(this, key);
+}
+
 /**
  *  Retrieve the original implementation
  *
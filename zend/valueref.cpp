@@ -0,0 +1,266 @@
+/**
+ *  ValueRef.cpp
+ *
+ *  Implementation of the ValueRef class
+ *
+ *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
+ *  @copyright 2019 Copernica BV
+ */
+#include "includes.h"
+#include "conversion.h"
+#include "keytable.h"
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Helper function to get the hash table of an array, or the property
+ *  table of an object
+ *  @param  val
+ *  @return HashTable
+ */
+static HashTable *members(zval *val)
+{
+    // check the type
+    switch (Z_TYPE_P(val)) {
+    case IS_ARRAY:  return Z_ARRVAL_P(val);
+    case IS_OBJECT: return Z_OBJ_HT_P(val)->get_properties ? Z_OBJPROP_P(val) : nullptr;
+    default:        return nullptr;
+    }
+}
+
+/**
+ *  Helper function to turn the result of a lookup into a reference
+ *  @param  result      The found element, or nullptr
+ *  @return ValueRef
+ */
+static ValueRef found(zval **result)
+{
+    // we need the tsrm_ls variable
+    TSRMLS_FETCH();
+
+    // elements that do not exist refer to the global null variable
+    return ValueRef(result ? *result : &EG(uninitialized_zval));
+}
+
+/**
+ *  Constructor to refer to the variable held by a Php::Value
+ *  @param  value       The value to refer to
+ */
+ValueRef::ValueRef(const Value &value) : _val(value._val) {}
+
+/**
+ *  The type of the variable
+ *  @return Type
+ */
+Type ValueRef::type() const
+{
+    return (Type)Z_TYPE_P(_val);
+}
+
+/**
+ *  Retrieve the value as number
+ *  @return int64_t
+ */
+int64_t ValueRef::numericValue() const
+{
+    return Conversion::numericValue(_val);
+}
+
+/**
+ *  Retrieve the value as boolean
+ *  @return bool
+ */
+bool ValueRef::boolValue() const
+{
+    return Conversion::boolValue(_val);
+}
+
+/**
+ *  Retrieve the value as a string
+ *  @return std::string
+ */
+std::string ValueRef::stringValue() const
+{
+    return Conversion::stringValue(_val);
+}
+
+/**
+ *  Get a borrowed view on the string buffer
+ *  @return StringView
+ */
+StringView ValueRef::stringView() const
+{
+    // must be a string
+    if (Z_TYPE_P(_val) == IS_STRING) return StringView(Z_STRVAL_P(_val), Z_STRLEN_P(_val));
+
+    // there is no string to view
+    return StringView();
+}
+
+/**
+ *  Retrieve the value as decimal
+ *  @return double
+ */
+double ValueRef::floatValue() const
+{
+    return Conversion::floatValue(_val);
+}
+
+/**
+ *  The number of elements in the array, or the length of the string
+ *  @return int
+ */
+int ValueRef::size() const
+{
+    // check the type
+    switch (Z_TYPE_P(_val)) {
+    case IS_ARRAY:      return zend_hash_num_elements(Z_ARRVAL_P(_val));
+    case IS_STRING:     return Z_STRLEN_P(_val);
+    case IS_OBJECT:     break;
+    default:            return 0;
+    }
+
+    // the count_elements member function should be defined
+    if (!Z_OBJ_HT_P(_val)->count_elements) return 0;
+
+    // create a variable to hold the result
+    long result;
+
+    // we need the tsrm_ls variable
+    TSRMLS_FETCH();
+
+    // call the function
+    return Z_OBJ_HT_P(_val)->count_elements(_val, &result TSRMLS_CC) == SUCCESS ? result : 0;
+}
+
+/**
+ *  Is a certain index set in the array or object?
+ *  @param  index
+ *  @return bool
+ */
+bool ValueRef::contains(int index) const
+{
+    // the elements
+    HashTable *table = members(_val);
+
+    // check if the index exists
+    return table && zend_hash_index_exists(table, index);
+}
+
+/**
+ *  Is a certain key set in the array or object?
+ *  @param  key
+ *  @param  size
+ *  @return bool
+ */
+bool ValueRef::contains(const char *key, int size) const
+{
+    // the elements
+    HashTable *table = members(_val);
+
+    // check if the key exists (zend_symtable also finds numeric keys like "12")
+    return table && zend_symtable_exists(table, key, size + 1);
+}
+
+/**
+ *  Is a certain key set in the array or object?
+ *  @param  key
+ *  @return bool
+ */
+bool ValueRef::contains(const Key &key) const
+{
+    // the elements
+    HashTable *table = members(_val);
+
+    // no elements
+    if (!table) return false;
+
+    // check if the key exists, without hashing it again
+    return exists(table, key);
+}
+
+/**
+ *  Get access to a member of the array or object
+ *  @param  index
+ *  @return ValueRef
+ */
+ValueRef ValueRef::get(int index) const
+{
+    // the elements
+    HashTable *table = members(_val);
+
+    // the element that is found
+    zval **result;
+
+    // look up the element
+    return found(table && zend_hash_index_find(table, index, (void **)&result) == SUCCESS ? result : nullptr);
+}
+
+/**
+ *  Get access to a member of the array or object
+ *  @param  key
+ *  @param  size
+ *  @return ValueRef
+ */
+ValueRef ValueRef::get(const char *key, int size) const
+{
+    // the elements
+    HashTable *table = members(_val);
+
+    // the element that is found
+    zval **result;
+
+    // look up the element (zend_symtable also finds numeric keys like "12")
+    return found(table && zend_symtable_find(table, key, size + 1, (void **)&result) == SUCCESS ? result : nullptr);
+}
+
+/**
+ *  Get access to a member of the array or object
+ *  @param  key
+ *  @return ValueRef
+ */
+ValueRef ValueRef::get(const Key &key) const
+{
+    // the elements
+    HashTable *table = members(_val);
+
+    // look up the element, without hashing the key again
+    return found(table ? find(table, key) : nullptr);
+}
+
+/**
+ *  Visit all elements of the array or object
+ *  @param  numeric     Callback for elements with a numeric key
+ *  @param  string      Callback for elements with a string key
+ *  @param  data        The visitor that is passed to the callbacks
+ */
+void ValueRef::forEach(void (*numeric)(void *data, int64_t key, const ValueRef &value), void (*string)(void *data, const StringView &key, const ValueRef &value), void *data) const
+{
+    // objects are visited by the value class, that uses the regular iterator
+    if (Z_TYPE_P(_val) == IS_OBJECT) return Value(_val).forEach(numeric, string, data);
+
+    // only works for arrays, other types have no elements
+    if (Z_TYPE_P(_val) != IS_ARRAY) return;
+
+    // the hash table to walk over
+    HashTable *table = Z_ARRVAL_P(_val);
+
+    // walk over the buckets, the keys and values are passed on without making copies
+    for (Bucket *bucket = table->pListHead; bucket; bucket = bucket->pListNext)
+    {
+        // the value that is stored in the bucket
+        ValueRef value(*(zval **)bucket->pData);
+
+        // pass on the key and the value
+        if (bucket->nKeyLength == 0) numeric(data, (long)bucket->h, value);
+        else string(data, StringView(bucket->arKey, bucket->nKeyLength - 1), value);
+    }
+}
+
+/**
+ *  End of namespace
+ */
+}
@@ -111,8 +111,8 @@ void ZendCallable::yield(struct _zval_struct *return_value, std::nullptr_t value
  */
 void ZendCallable::yield(struct _zval_struct *return_value, Php::Value &&value)
 {
-    // copy the value over to the return value
-    RETVAL_ZVAL(value._val, 1, 0);
+    // move the value into the return value (this avoids copying strings and arrays)
+    value.moveTo(return_value);
 }
 
 /**